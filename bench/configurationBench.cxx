@@ -0,0 +1,215 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include <benchmark/benchmark.h>
+
+#include "configuration.h"
+
+//-------------------------------------------------------------------------
+
+using namespace std::chrono_literals;
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+const std::string c_minimalConfig
+{
+    "lidshutdownsecs=300\n"
+};
+
+const std::string c_argonConfig
+{
+    "#\n"
+    "# Argon One Up configuration\n"
+    "#\n"
+    "# Number of seconds the lid must be closed before shutting down.\n"
+    "# Set to 0 to disable.\n"
+    "#\n"
+    "\n"
+    "lidshutdownsecs = 300\n"
+};
+
+std::string
+makeCommentedConfig(
+    int comments)
+{
+    std::string config;
+
+    for (int i = 0 ; i < comments ; ++i)
+    {
+        config += "# a comment line that is skipped by the parser\n";
+        config += "\n";
+    }
+
+    config += "  lidshutdownsecs\t=\t1800 # thirty minutes\n";
+
+    return config;
+}
+
+//-------------------------------------------------------------------------
+
+std::string_view
+trim(
+    const std::string_view str)
+{
+    auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)); };
+
+    const auto start = std::find_if_not(begin(str), end(str), isSpace);
+    if (start == end(str))
+    {
+        return {};
+    }
+
+    const auto finish = std::find_if_not(rbegin(str), rend(str), isSpace);
+    return str.substr(start - begin(str), finish.base() - start);
+}
+
+//-------------------------------------------------------------------------
+
+// The regex based parser this program used up to version 1.2.0, reading
+// from a stream rather than the file so only parsing is measured.
+
+std::chrono::seconds
+regexShutdownTimeout(
+    const std::string& text)
+{
+    std::istringstream iss(text);
+
+    std::string line;
+    while (std::getline(iss, line))
+    {
+        line = trim(line);
+
+        if (line.starts_with("#") || line.empty())
+        {
+            continue;
+        }
+
+        const std::regex pattern{R"(\s*lidshutdownsecs\s*=\s*(\d+))"};
+        std::smatch matches;
+        if (std::regex_search(line, matches, pattern))
+        {
+            return std::chrono::seconds(std::stoul(matches[1].str()));
+        }
+    }
+
+    return 0s;
+}
+
+//-------------------------------------------------------------------------
+
+std::chrono::seconds
+viewShutdownTimeout(
+    const std::string& text)
+{
+    Configuration configuration;
+    parseConfiguration(text, configuration);
+
+    return configuration.lidShutdownTimeout;
+}
+
+//-------------------------------------------------------------------------
+
+const std::string&
+config(
+    std::int64_t index)
+{
+    static const std::array configs
+    {
+        c_minimalConfig,
+        c_argonConfig,
+        makeCommentedConfig(50)
+    };
+
+    return configs.at(static_cast<std::size_t>(index));
+}
+
+//-------------------------------------------------------------------------
+
+void
+setConfigLabel(
+    benchmark::State& state)
+{
+    static constexpr std::array c_names{ "minimal", "argon", "commented" };
+    state.SetLabel(c_names.at(static_cast<std::size_t>(state.range(0))));
+}
+
+//-------------------------------------------------------------------------
+
+void
+BM_regexShutdownTimeout(
+    benchmark::State& state)
+{
+    const auto& text = config(state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(regexShutdownTimeout(text));
+    }
+
+    setConfigLabel(state);
+}
+
+BENCHMARK(BM_regexShutdownTimeout)->DenseRange(0, 2);
+
+//-------------------------------------------------------------------------
+
+void
+BM_parseConfiguration(
+    benchmark::State& state)
+{
+    const auto& text = config(state.range(0));
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(viewShutdownTimeout(text));
+    }
+
+    setConfigLabel(state);
+}
+
+BENCHMARK(BM_parseConfiguration)->DenseRange(0, 2);
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
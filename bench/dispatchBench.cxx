@@ -0,0 +1,173 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <unistd.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <format>
+#include <print>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "argonOneUpLidMonitor.h"
+#include "discardStderr.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+constexpr std::array<gpiod::line::offset, 3> c_offsets{ 27, 17, 22 };
+constexpr std::size_t c_traceEdges{10'000};
+
+//-------------------------------------------------------------------------
+
+// Writes a trace of edges spread over the lid switch and two other lines,
+// removed again when it goes out of scope. Most of the edges are bounces
+// a few hundred microseconds apart, with a settled change every 100ms.
+
+class TraceFile
+{
+public:
+
+    TraceFile()
+    :
+        m_path{std::filesystem::temp_directory_path() / std::format("dispatchBench.{}.trace", ::getpid())}
+    {
+        std::FILE* file = std::fopen(m_path.c_str(), "w");
+        if (file == nullptr)
+        {
+            throw std::system_error(errno, std::generic_category(), "fopen");
+        }
+
+        std::uint64_t timestampNs{0};
+
+        for (std::size_t i = 0 ; i < c_traceEdges ; ++i)
+        {
+            timestampNs += (i % 8 == 0) ? 100'000'000 : 300'000;
+
+            std::println(
+                file,
+                "{} {} {}",
+                timestampNs,
+                c_offsets[(i / 8) % c_offsets.size()],
+                (i % 2 == 0) ? "falling" : "rising");
+        }
+
+        std::fclose(file);
+    }
+
+    ~TraceFile()
+    {
+        std::error_code error;
+        std::filesystem::remove(m_path, error);
+    }
+
+    TraceFile(const TraceFile&) = delete;
+    TraceFile& operator=(const TraceFile&) = delete;
+
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return m_path; }
+
+private:
+
+    std::filesystem::path m_path{};
+};
+
+//-------------------------------------------------------------------------
+
+// The monitor's own dispatch, ArgonOneUpLidMonitor::handleLineEvents(),
+// draining the whole trace in one wakeup: the sequence number check, the
+// debounce, the edge history and the lid state machine, with a countdown
+// armed and cancelled as the lid closes and opens. Only the lid line is
+// monitored, since an input would start its command, so the edges on the
+// other lines are read and ignored. range(0) is the debounce period in
+// milliseconds.
+
+void
+BM_handleLineEvents(
+    benchmark::State& state)
+{
+    const DiscardStderr discard;
+    const TraceFile trace;
+
+    std::array<std::string, 9> arguments
+    {
+        "dispatchBench",
+        "--replay", trace.path().string(),
+        "--line", std::to_string(c_offsets[0]),
+        "--debounce", std::to_string(state.range(0)),
+        "--action", "60:true"
+    };
+
+    std::vector<char*> argv;
+    for (auto& argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    argv.push_back(nullptr);
+
+    std::atomic<bool> run{true};
+    ArgonOneUpLidMonitor monitor{&run};
+
+    // getopt keeps its position between calls, so start it again for each
+    // run of the benchmark.
+
+    optind = 0;
+    if (monitor.parseCommandLine(static_cast<int>(arguments.size()), argv.data()).has_value())
+    {
+        state.SkipWithError("invalid command line");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        monitor.prepareReplay();
+        state.ResumeTiming();
+
+        monitor.handleLineEvents();
+    }
+
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * c_traceEdges));
+}
+
+BENCHMARK(BM_handleLineEvents)->Arg(0)->Arg(20);
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,880 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+// Soak test for the monitor using a gpio-sim chip. It creates a simulated
+// chip with the lid switch on line 27, starts the monitor on it and drives
+// the line with bursts of bounces, settling on alternate lid states. After
+// each burst it checks the lid state over the control socket. It then
+// leaves the line alone and checks that the monitor does not wake up at
+// all. At the end it prints a JSON object of the results, from the
+// monitor's own metrics and from /proc, for tracking between releases.
+//
+// Needs root, configfs mounted at /sys/kernel/config and the gpio-sim
+// module loaded. The monitor shares /run with any running service, so stop
+// the service first.
+
+#include <fcntl.h>
+#include <getopt.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <print>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "fileDescriptor.h"
+
+//-------------------------------------------------------------------------
+
+extern char** environ;
+
+using namespace std::chrono_literals;
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+const std::filesystem::path c_configfsPath{"/sys/kernel/config/gpio-sim"};
+const std::filesystem::path c_platformPath{"/sys/devices/platform"};
+
+constexpr unsigned c_lidOffset{27};
+constexpr unsigned c_numLines{32};
+
+// Long enough for the monitor to have handled one control request before
+// the next is made.
+
+constexpr std::chrono::milliseconds c_requestSpacing{200};
+
+//-------------------------------------------------------------------------
+
+struct Settings
+{
+    std::filesystem::path daemon{"./argonOneUpLidMonitor"};
+    unsigned rate{2000};
+    unsigned bounces{50};
+    unsigned cycles{100};
+    std::chrono::milliseconds debounce{20};
+    std::chrono::milliseconds settle{100};
+    std::chrono::seconds idle{5};
+    bool random{false};
+};
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+monotonicNow() noexcept
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+//-------------------------------------------------------------------------
+
+void
+sleepUntil(
+    std::chrono::nanoseconds deadline) noexcept
+{
+    const auto seconds = std::chrono::floor<std::chrono::seconds>(deadline);
+
+    timespec ts{};
+    ts.tv_sec = static_cast<time_t>(seconds.count());
+    ts.tv_nsec = static_cast<long>((deadline - seconds).count());
+
+    while (::clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+    {
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+writeFile(
+    const std::filesystem::path& path,
+    std::string_view text)
+{
+    const FileDescriptor fd{::open(path.c_str(), O_WRONLY | O_CLOEXEC)};
+    if (not fd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), path.string());
+    }
+
+    if (::write(fd.get(), text.data(), text.size()) != static_cast<ssize_t>(text.size()))
+    {
+        throw std::system_error(errno, std::generic_category(), path.string());
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+readFile(
+    const std::filesystem::path& path)
+{
+    std::ifstream stream{path};
+    if (not stream)
+    {
+        throw std::runtime_error(std::format("cannot read \"{}\"", path.string()));
+    }
+
+    std::string text{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+
+    while (not text.empty() and text.back() == '\n')
+    {
+        text.pop_back();
+    }
+
+    return text;
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<std::uint64_t>
+parseUnsigned(
+    std::string_view str)
+{
+    std::uint64_t value{0};
+    const auto last = str.data() + str.size();
+    const auto [ptr, ec] = std::from_chars(str.data(), last, value);
+
+    if (ec != std::errc{} or ptr != last)
+    {
+        return std::nullopt;
+    }
+
+    return value;
+}
+
+//-------------------------------------------------------------------------
+
+// The value of a counter in the Prometheus text format, or zero.
+
+std::uint64_t
+metric(
+    std::string_view text,
+    std::string_view name)
+{
+    for (std::size_t start = 0 ; start < text.size() ; )
+    {
+        const auto end = std::min(text.find('\n', start), text.size());
+        const auto line = text.substr(start, end - start);
+
+        if (line.starts_with(name) and line.size() > name.size() and line[name.size()] == ' ')
+        {
+            return parseUnsigned(line.substr(name.size() + 1)).value_or(0);
+        }
+
+        start = end + 1;
+    }
+
+    return 0;
+}
+
+//-------------------------------------------------------------------------
+
+// A gpio-sim chip with one bank. The line is driven by setting its pull,
+// which the simulator turns into edges on the requested input.
+
+class GpioSim
+{
+public:
+
+    GpioSim();
+    ~GpioSim();
+
+    GpioSim(const GpioSim&) = delete;
+    GpioSim& operator=(const GpioSim&) = delete;
+
+    [[nodiscard]] std::filesystem::path chip() const { return "/dev" / m_chipName; }
+
+    void set(bool high);
+
+private:
+
+    void remove() noexcept;
+
+    std::filesystem::path m_device{};
+    std::filesystem::path m_bank{};
+    std::filesystem::path m_line{};
+    std::filesystem::path m_chipName{};
+    FileDescriptor m_pull{};
+    bool m_live{false};
+};
+
+//-------------------------------------------------------------------------
+
+GpioSim::GpioSim()
+:
+    m_device{c_configfsPath / std::format("argonOneUpSoak{}", ::getpid())},
+    m_bank{m_device / "bank0"},
+    m_line{m_bank / std::format("line{}", c_lidOffset)},
+    m_chipName{},
+    m_pull{},
+    m_live{false}
+{
+    try
+    {
+        for (const auto& directory : { m_device, m_bank, m_line })
+        {
+            if (::mkdir(directory.c_str(), 0755) == -1)
+            {
+                throw std::system_error(errno, std::generic_category(), directory.string());
+            }
+        }
+
+        writeFile(m_bank / "num_lines", std::to_string(c_numLines));
+        writeFile(m_line / "name", std::format("GPIO{}", c_lidOffset));
+        writeFile(m_device / "live", "1");
+        m_live = true;
+
+        m_chipName = readFile(m_bank / "chip_name");
+
+        const auto pull = c_platformPath
+                        / readFile(m_device / "dev_name")
+                        / m_chipName
+                        / std::format("sim_gpio{}", c_lidOffset)
+                        / "pull";
+
+        m_pull = FileDescriptor{::open(pull.c_str(), O_WRONLY | O_CLOEXEC)};
+        if (not m_pull.valid())
+        {
+            throw std::system_error(errno, std::generic_category(), pull.string());
+        }
+    }
+    catch (...)
+    {
+        remove();
+        throw;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+GpioSim::~GpioSim()
+{
+    remove();
+}
+
+//-------------------------------------------------------------------------
+
+void
+GpioSim::remove() noexcept
+{
+    m_pull.close();
+
+    if (m_live)
+    {
+        try
+        {
+            writeFile(m_device / "live", "0");
+        }
+        catch (const std::exception&)
+        {
+        }
+
+        m_live = false;
+    }
+
+    for (const auto& directory : { m_line, m_bank, m_device })
+    {
+        ::rmdir(directory.c_str());
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+GpioSim::set(
+    bool high)
+{
+    const std::string_view pull = high ? "pull-up" : "pull-down";
+
+    if (::pwrite(m_pull.get(), pull.data(), pull.size(), 0) != static_cast<ssize_t>(pull.size()))
+    {
+        throw std::system_error(errno, std::generic_category(), "gpio-sim pull");
+    }
+}
+
+//-------------------------------------------------------------------------
+
+// The monitor under test, talked to over its control socket.
+
+class Daemon
+{
+public:
+
+    Daemon(const Settings& settings, const std::filesystem::path& chip);
+    ~Daemon();
+
+    Daemon(const Daemon&) = delete;
+    Daemon& operator=(const Daemon&) = delete;
+
+    [[nodiscard]] bool running();
+    [[nodiscard]] std::chrono::nanoseconds cpuTime() const;
+    [[nodiscard]] std::uint64_t contextSwitches() const;
+
+    std::string request(std::string_view request);
+    int stop();
+
+private:
+
+    std::filesystem::path m_socketPath{};
+    pid_t m_pid{-1};
+    std::optional<int> m_status{};
+};
+
+//-------------------------------------------------------------------------
+
+Daemon::Daemon(
+    const Settings& settings,
+    const std::filesystem::path& chip)
+:
+    m_socketPath{std::format("/run/argonOneUpSoak{}.sock", ::getpid())},
+    m_pid{-1},
+    m_status{}
+{
+    // A harmless shutdown command, as a closed lid arms the countdown.
+
+    const auto debounce = std::to_string(settings.debounce.count());
+
+    std::vector<std::string> args
+    {
+        settings.daemon.string(),
+        "--chip", chip.string(),
+        "--line", std::to_string(c_lidOffset),
+        "--controlSocket", m_socketPath.string(),
+        "--debounce", debounce,
+        "--historyFile", "",
+        "--shutdownCommand", "true"
+    };
+
+    std::vector<char*> argv;
+    for (auto& arg : args)
+    {
+        argv.push_back(arg.data());
+    }
+    argv.push_back(nullptr);
+
+    if (const int error = ::posix_spawn(&m_pid, argv[0], nullptr, nullptr, argv.data(), environ); error != 0)
+    {
+        throw std::system_error(error, std::generic_category(), "posix_spawn");
+    }
+
+    // Ready once the control socket answers.
+
+    const auto deadline = monotonicNow() + 5s;
+
+    while (monotonicNow() < deadline)
+    {
+        try
+        {
+            request("state");
+            return;
+        }
+        catch (const std::system_error&)
+        {
+            if (not running())
+            {
+                throw std::runtime_error("monitor exited during startup");
+            }
+
+            std::this_thread::sleep_for(10ms);
+        }
+    }
+
+    stop();
+    throw std::runtime_error("monitor control socket did not answer");
+}
+
+//-------------------------------------------------------------------------
+
+Daemon::~Daemon()
+{
+    stop();
+}
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+Daemon::cpuTime() const
+{
+    // utime and stime are the 14th and 15th fields, counting from the
+    // pid. The command name is in parentheses and may contain spaces.
+
+    const auto stat = readFile(std::format("/proc/{}/stat", m_pid));
+
+    std::string_view fields{stat};
+    fields.remove_prefix(std::min(fields.rfind(')') + 2, fields.size()));
+
+    std::uint64_t ticks{0};
+
+    for (int field = 3 ; field <= 15 and not fields.empty() ; ++field)
+    {
+        const auto end = std::min(fields.find(' '), fields.size());
+
+        if (field >= 14)
+        {
+            ticks += parseUnsigned(fields.substr(0, end)).value_or(0);
+        }
+
+        fields.remove_prefix(std::min(end + 1, fields.size()));
+    }
+
+    const auto ticksPerSecond = static_cast<std::uint64_t>(::sysconf(_SC_CLK_TCK));
+
+    return std::chrono::nanoseconds(ticks * 1'000'000'000 / ticksPerSecond);
+}
+
+//-------------------------------------------------------------------------
+
+std::uint64_t
+Daemon::contextSwitches() const
+{
+    // Every wakeup of a thread of the monitor is a context switch, so sum
+    // them over all of its threads.
+
+    std::uint64_t switches{0};
+
+    for (const auto& task : std::filesystem::directory_iterator(std::format("/proc/{}/task", m_pid)))
+    {
+        std::ifstream stream{task.path() / "status"};
+
+        for (std::string line ; std::getline(stream, line) ; )
+        {
+            for (const std::string_view name : { "voluntary_ctxt_switches:", "nonvoluntary_ctxt_switches:" })
+            {
+                if (line.starts_with(name))
+                {
+                    std::string_view value{line};
+                    value.remove_prefix(name.size());
+                    value.remove_prefix(std::min(value.find_first_not_of(" \t"), value.size()));
+                    switches += parseUnsigned(value).value_or(0);
+                }
+            }
+        }
+    }
+
+    return switches;
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+Daemon::request(
+    std::string_view request)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, m_socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    const FileDescriptor fd{::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0)};
+    if (not fd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), "socket");
+    }
+
+    if (::connect(fd.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "connect");
+    }
+
+    if (::send(fd.get(), request.data(), request.size(), 0) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "send");
+    }
+
+    std::string reply(65536, '\0');
+
+    const auto length = ::recv(fd.get(), reply.data(), reply.size(), 0);
+    if (length == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "recv");
+    }
+
+    reply.resize(static_cast<std::size_t>(length));
+    return reply;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+Daemon::running()
+{
+    if (m_status.has_value())
+    {
+        return false;
+    }
+
+    int status{0};
+    if (::waitpid(m_pid, &status, WNOHANG) == m_pid)
+    {
+        m_status = status;
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+int
+Daemon::stop()
+{
+    if (running())
+    {
+        ::kill(m_pid, SIGTERM);
+
+        int status{0};
+        while (::waitpid(m_pid, &status, 0) == -1 and errno == EINTR)
+        {
+        }
+
+        m_status = status;
+    }
+
+    return m_status.value_or(0);
+}
+
+//-------------------------------------------------------------------------
+
+// One burst of bounces at the edge rate, leaving the line at its final
+// value. With the random pattern the gaps between edges are exponentially
+// distributed around the same mean, so some edges come much closer
+// together.
+
+std::uint64_t
+burst(
+    GpioSim& sim,
+    const Settings& settings,
+    bool final,
+    std::mt19937_64& generator)
+{
+    const std::chrono::nanoseconds mean{1'000'000'000 / settings.rate};
+    std::exponential_distribution<double> gap{1.0 / static_cast<double>(mean.count())};
+
+    // An even number of bounces ends where the burst started, so finish on
+    // the final value with one more edge.
+
+    auto value = (settings.bounces % 2 == 0) ? not final : final;
+    auto next = monotonicNow();
+    std::uint64_t edges{0};
+
+    for (unsigned i = 0 ; i <= settings.bounces ; ++i)
+    {
+        next += settings.random
+              ? std::chrono::nanoseconds(static_cast<std::int64_t>(gap(generator)))
+              : mean;
+
+        sleepUntil(next);
+
+        value = not value;
+        sim.set(value);
+        ++edges;
+    }
+
+    return edges;
+}
+
+//-------------------------------------------------------------------------
+
+void
+printUsage(
+    std::FILE* stream,
+    const char* programName)
+{
+    const Settings defaults;
+
+    std::println(stream, "");
+    std::println(stream, "Usage: {}", programName);
+    std::println(stream, "");
+    std::println(stream, "    --bounces,-b <edges> - edges in each burst before the line settles (default: {})", defaults.bounces);
+    std::println(stream, "    --cycles,-n <bursts> - number of bursts, settling on alternate lid states (default: {})", defaults.cycles);
+    std::println(stream, "    --daemon,-D <path> - monitor to test (default: {})", defaults.daemon.string());
+    std::println(stream, "    --debounce,-d <milliseconds> - debounce period given to the monitor (default: {})", defaults.debounce.count());
+    std::println(stream, "    --help,-h - print usage and exit");
+    std::println(stream, "    --idle,-i <seconds> - time the line is left alone at the end, in which the monitor must not wake up (default: {})", defaults.idle.count());
+    std::println(stream, "    --random,-x - exponentially distributed gaps between edges rather than regular ones");
+    std::println(stream, "    --rate,-r <edges per second> - edge rate within a burst (default: {})", defaults.rate);
+    std::println(stream, "    --settle,-s <milliseconds> - time the line is left settled after each burst (default: {})", defaults.settle.count());
+    std::println(stream, "");
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<int>
+parseCommandLine(
+    int argc,
+    char* argv[],
+    Settings& settings)
+{
+    static const char* sopts = "b:d:D:hi:n:r:s:x";
+    static option lopts[] =
+    {
+        { "bounces", required_argument, nullptr, 'b' },
+        { "cycles", required_argument, nullptr, 'n' },
+        { "daemon", required_argument, nullptr, 'D' },
+        { "debounce", required_argument, nullptr, 'd' },
+        { "help", no_argument, nullptr, 'h' },
+        { "idle", required_argument, nullptr, 'i' },
+        { "random", no_argument, nullptr, 'x' },
+        { "rate", required_argument, nullptr, 'r' },
+        { "settle", required_argument, nullptr, 's' },
+        { nullptr, no_argument, nullptr, 0 }
+    };
+
+    int opt{0};
+
+    while ((opt = ::getopt_long(argc, argv, sopts, lopts, nullptr)) != -1)
+    {
+        const auto value = (optarg != nullptr) ? parseUnsigned(optarg) : std::nullopt;
+
+        if (optarg != nullptr and opt != 'D' and not value.has_value())
+        {
+            std::println(stderr, "invalid number \"{}\"", optarg);
+            printUsage(stderr, argv[0]);
+            return EXIT_FAILURE;
+        }
+
+        switch (opt)
+        {
+        case 'b':
+
+            settings.bounces = static_cast<unsigned>(*value);
+            break;
+
+        case 'd':
+
+            settings.debounce = std::chrono::milliseconds(*value);
+            break;
+
+        case 'D':
+
+            settings.daemon = optarg;
+            break;
+
+        case 'h':
+
+            printUsage(stdout, argv[0]);
+            return EXIT_SUCCESS;
+
+        case 'i':
+
+            settings.idle = std::chrono::seconds(*value);
+            break;
+
+        case 'n':
+
+            settings.cycles = static_cast<unsigned>(*value);
+            break;
+
+        case 'r':
+
+            if (*value == 0)
+            {
+                std::println(stderr, "the edge rate must be at least 1");
+                return EXIT_FAILURE;
+            }
+
+            settings.rate = static_cast<unsigned>(*value);
+            break;
+
+        case 's':
+
+            settings.settle = std::chrono::milliseconds(*value);
+            break;
+
+        case 'x':
+
+            settings.random = true;
+            break;
+
+        default:
+
+            printUsage(stderr, argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return std::nullopt;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+int
+main(
+    int argc,
+    char* argv[])
+{
+    Settings settings;
+
+    if (const auto result = parseCommandLine(argc, argv, settings); result.has_value())
+    {
+        return *result;
+    }
+
+    try
+    {
+        GpioSim sim;
+        sim.set(true);
+
+        Daemon daemon{settings, sim.chip()};
+
+        const auto startWakeups = static_cast<std::int64_t>(
+            metric(daemon.request("metrics"), "argononeup_wakeups_total"));
+        const auto startCpu = daemon.cpuTime();
+        const auto startSwitches = daemon.contextSwitches();
+        const auto start = monotonicNow();
+
+        std::mt19937_64 generator{c_lidOffset};
+        std::uint64_t edges{0};
+        unsigned stateErrors{0};
+
+        for (unsigned cycle = 0 ; cycle < settings.cycles and daemon.running() ; ++cycle)
+        {
+            // Open is the line high, so alternate closed and open.
+
+            const bool open = (cycle % 2 == 1);
+            edges += burst(sim, settings, open, generator);
+
+            std::this_thread::sleep_for(settings.settle);
+
+            const auto expected = open ? "lid=open\n" : "lid=closed\n";
+            if (not daemon.request("state").starts_with(expected))
+            {
+                ++stateErrors;
+            }
+        }
+
+        const auto elapsed = std::chrono::duration<double>(monotonicNow() - start).count();
+        const auto cpu = std::chrono::duration<double>(daemon.cpuTime() - startCpu).count();
+        const auto switches = daemon.contextSwitches() - startSwitches;
+        const auto wakeups = static_cast<std::int64_t>(
+            metric(daemon.request("metrics"), "argononeup_wakeups_total")) - startWakeups;
+
+        // Let any debounce timer run out, then count the wakeups while the
+        // lid is left alone. Each control request wakes the monitor more
+        // than once (the connection, the request and the hang up), and the
+        // count in a reply includes the hang up of the request before it,
+        // so the cost of one request is measured from two requests and
+        // taken off the count across the idle time. Back to back, the hang
+        // up and the next connection can share one wakeup, so the two are
+        // spaced apart as the idle requests are.
+
+        std::this_thread::sleep_for(std::max<std::chrono::nanoseconds>(2 * settings.debounce, 200ms));
+
+        const auto wakeupCount = [&daemon]
+        {
+            return static_cast<std::int64_t>(metric(daemon.request("metrics"), "argononeup_wakeups_total"));
+        };
+
+        const auto calibrateStart = wakeupCount();
+        std::this_thread::sleep_for(c_requestSpacing);
+        const auto idleStart = wakeupCount();
+        const auto requestWakeups = idleStart - calibrateStart;
+        std::this_thread::sleep_for(settings.idle);
+        const auto metrics = daemon.request("metrics");
+        const auto idleWakeups = static_cast<std::int64_t>(metric(metrics, "argononeup_wakeups_total"))
+                               - idleStart
+                               - requestWakeups;
+
+        const bool survived = daemon.running();
+        const auto status = daemon.stop();
+
+        std::println(
+            "{{\"pattern\":\"{}\",\"rate\":{},\"bounces\":{},\"cycles\":{},\"debounce_ms\":{},\"settle_ms\":{},"
+            "\"duration_s\":{:.3f},\"edges_driven\":{},\"state_errors\":{},"
+            "\"edges_missed\":{},\"edge_gaps\":{},\"debounce_suppressed\":{},"
+            "\"lid_opened\":{},\"lid_closed\":{},\"shutdown_armed\":{},\"shutdown_cancelled\":{},"
+            "\"cpu_s\":{:.3f},\"cpu_percent\":{:.2f},\"context_switches\":{},\"context_switches_per_s\":{:.1f},"
+            "\"wakeups\":{},\"wakeups_per_s\":{:.1f},"
+            "\"idle_s\":{},\"request_wakeups\":{},\"idle_wakeups\":{},"
+            "\"survived\":{},\"exit_status\":{}}}",
+            settings.random ? "random" : "regular",
+            settings.rate,
+            settings.bounces,
+            settings.cycles,
+            settings.debounce.count(),
+            settings.settle.count(),
+            elapsed,
+            edges,
+            stateErrors,
+            metric(metrics, "argononeup_edges_missed_total"),
+            metric(metrics, "argononeup_edge_gaps_total"),
+            metric(metrics, "argononeup_debounce_suppressed_total"),
+            metric(metrics, "argononeup_lid_opened_total"),
+            metric(metrics, "argononeup_lid_closed_total"),
+            metric(metrics, "argononeup_shutdown_armed_total"),
+            metric(metrics, "argononeup_shutdown_cancelled_total"),
+            cpu,
+            100.0 * cpu / elapsed,
+            switches,
+            static_cast<double>(switches) / elapsed,
+            wakeups,
+            static_cast<double>(wakeups) / elapsed,
+            settings.idle.count(),
+            requestWakeups,
+            idleWakeups,
+            survived,
+            WIFEXITED(status) ? WEXITSTATUS(status) : -1);
+
+        return (stateErrors == 0 and idleWakeups == 0 and survived) ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    catch (const std::exception& e)
+    {
+        std::println(stderr, "soak test failed: {}", e.what());
+        return EXIT_FAILURE;
+    }
+}
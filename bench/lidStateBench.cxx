@@ -0,0 +1,150 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+#include "argonOneUpLidMonitor.h"
+#include "lidStateMachine.h"
+#include "monitoredLine.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+constexpr std::array c_values
+{
+    gpiod::line::value::ACTIVE,
+    gpiod::line::value::INACTIVE
+};
+
+constexpr std::array c_states
+{
+    ArgonOneUpLidMonitor::LidState::UNKNOWN,
+    ArgonOneUpLidMonitor::LidState::OPEN,
+    ArgonOneUpLidMonitor::LidState::CLOSED
+};
+
+//-------------------------------------------------------------------------
+
+void
+BM_valueTypeToLidState(
+    benchmark::State& state)
+{
+    std::size_t i{0};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            ArgonOneUpLidMonitor::valueTypeToLidState(c_values[i++ % c_values.size()]));
+    }
+}
+
+BENCHMARK(BM_valueTypeToLidState);
+
+//-------------------------------------------------------------------------
+
+void
+BM_toString(
+    benchmark::State& state)
+{
+    std::size_t i{0};
+
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(
+            ArgonOneUpLidMonitor::toString(c_states[i++ % c_states.size()]));
+    }
+}
+
+BENCHMARK(BM_toString);
+
+//-------------------------------------------------------------------------
+
+void
+BM_lidTransition(
+    benchmark::State& state)
+{
+    auto current = LidState::UNKNOWN;
+    std::size_t i{0};
+
+    for (auto _ : state)
+    {
+        const auto& transition = lidTransition(current, c_states[i++ % c_states.size()]);
+        current = transition.next;
+        benchmark::DoNotOptimize(transition.actions);
+    }
+}
+
+BENCHMARK(BM_lidTransition);
+
+//-------------------------------------------------------------------------
+
+// The edge type to lid state conversion now happens as a line accepts an
+// edge, so measure that with the handler the lid uses.
+
+void
+BM_edgeToLidState(
+    benchmark::State& state)
+{
+    auto lidState = ArgonOneUpLidMonitor::LidState::UNKNOWN;
+
+    MonitoredLine line{
+        .label = "lid",
+        .offset = 27,
+        .handler = [&lidState](gpiod::line::value value, std::uint64_t, std::uint64_t)
+        {
+            lidState = ArgonOneUpLidMonitor::valueTypeToLidState(value);
+        } };
+
+    EdgeEvent event{ .offset = 27 };
+
+    for (auto _ : state)
+    {
+        event.type = (event.type == gpiod::edge_event::event_type::RISING_EDGE)
+                   ? gpiod::edge_event::event_type::FALLING_EDGE
+                   : gpiod::edge_event::event_type::RISING_EDGE;
+        ++event.timestampNs;
+
+        line.accept(event);
+        line.settle();
+        benchmark::DoNotOptimize(lidState);
+    }
+}
+
+BENCHMARK(BM_edgeToLidState);
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,155 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <syslog.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <thread>
+
+#include <benchmark/benchmark.h>
+
+#include "discardStderr.h"
+#include "logger.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+using namespace std::chrono_literals;
+
+// Messages logged between pauses for the sink thread to catch up, well
+// within the ring.
+
+constexpr std::int64_t c_burst{Logger::c_capacity / 2};
+
+//-------------------------------------------------------------------------
+
+// The journal variants write real entries to the system journal, so they
+// only run if ARGONONEUP_BENCH_JOURNAL is set.
+
+bool
+skipJournal(
+    benchmark::State& state)
+{
+    if (state.range(0) != 0 and std::getenv("ARGONONEUP_BENCH_JOURNAL") == nullptr)
+    {
+        state.SkipWithError("set ARGONONEUP_BENCH_JOURNAL to write to the system journal");
+        return true;
+    }
+
+    return false;
+}
+
+//-------------------------------------------------------------------------
+
+// Synchronous messageLog, before the logger is started, which measures a
+// write by the sink. range(0) selects the journal sink.
+
+void
+BM_messageLogSynchronous(
+    benchmark::State& state)
+{
+    if (skipJournal(state))
+    {
+        return;
+    }
+
+    const bool journal = state.range(0) != 0;
+    const DiscardStderr discard;
+
+    Logger logger{journal};
+    logger.setIdentity("localhost", "argonOneUpLidMonitor_bench");
+
+    for (auto _ : state)
+    {
+        logger.log(LOG_INFO, "lid closed to shutdown armed latency benchmark message");
+    }
+
+    state.SetLabel(journal ? "journal" : "stderr");
+}
+
+BENCHMARK(BM_messageLogSynchronous)->Arg(0)->Arg(1);
+
+//-------------------------------------------------------------------------
+
+// messageLog with the sink thread running, which only measures copying
+// the message into the ring. The messages are logged in bursts, with the
+// timing paused between them while the sink thread empties the ring, so
+// that they are enqueued rather than dropped. Any that still found the
+// ring full are reported as the fraction dropped.
+
+void
+BM_messageLogAsynchronous(
+    benchmark::State& state)
+{
+    if (skipJournal(state))
+    {
+        return;
+    }
+
+    const bool journal = state.range(0) != 0;
+    const DiscardStderr discard;
+
+    Logger logger{journal};
+    logger.setIdentity("localhost", "argonOneUpLidMonitor_bench");
+    logger.start();
+
+    std::int64_t queued{0};
+
+    for (auto _ : state)
+    {
+        logger.log(LOG_INFO, "lid closed to shutdown armed latency benchmark message");
+
+        if (++queued == c_burst)
+        {
+            state.PauseTiming();
+            std::this_thread::sleep_for(2ms);
+            queued = 0;
+            state.ResumeTiming();
+        }
+    }
+
+    logger.stop();
+
+    state.counters["dropped"] = benchmark::Counter(
+        static_cast<double>(logger.dropped()),
+        benchmark::Counter::kAvgIterations);
+    state.SetLabel(journal ? "journal" : "stderr");
+}
+
+BENCHMARK(BM_messageLogAsynchronous)->Arg(0)->Arg(1)->Iterations(c_burst * 500);
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//-------------------------------------------------------------------------
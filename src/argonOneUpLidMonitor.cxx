@@ -26,30 +26,47 @@
 //-------------------------------------------------------------------------
 
 #include <errno.h>
+#include <fcntl.h>
 #include <getopt.h>
+#include <sys/epoll.h>
+#include <sched.h>
+#include <sys/resource.h>
+#include <sys/signalfd.h>
+#include <sys/wait.h>
 #include <syslog.h>
+#include <time.h>
 #include <unistd.h>
 
-#include <systemd/sd-journal.h>
+#include <systemd/sd-daemon.h>
 
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <charconv>
 #include <chrono>
-#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
 #include <filesystem>
 #include <format>
 #include <functional>
-#include <fstream>
-#include <map>
-#include <mutex>
+#include <memory>
 #include <print>
 #include <ranges>
-#include <regex>
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <string_view>
+#include <system_error>
+#include <utility>
 
 #include "argonOneUpLidMonitor.h"
 #include "config.h"
+#include "eventLoop.h"
+#include "fileWatcher.h"
+#include "gpiodEventSource.h"
+#include "replayEventSource.h"
+#include "startupTrace.h"
 
 //-------------------------------------------------------------------------
 
@@ -62,20 +79,59 @@ namespace
 
 //-------------------------------------------------------------------------
 
-std::string_view
-trim(
-    const std::string_view str)
+const std::filesystem::path c_configPath{"/etc/argononeupd.conf"};
+const std::filesystem::path c_historyPath{"/run/argonOneUpLidMonitor.history"};
+
+//-------------------------------------------------------------------------
+
+// The kernel timestamps gpio edge events using CLOCK_MONOTONIC.
+
+std::chrono::nanoseconds
+monotonicNow() noexcept
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+//-------------------------------------------------------------------------
+
+// The cpu time used by the calling thread.
+
+std::chrono::nanoseconds
+threadCpuTime() noexcept
+{
+    rusage usage{};
+    if (::getrusage(RUSAGE_THREAD, &usage) == -1)
+    {
+        return std::chrono::nanoseconds{0};
+    }
+
+    const auto timeval = [](const ::timeval& tv)
+    {
+        return std::chrono::seconds(tv.tv_sec) + std::chrono::microseconds(tv.tv_usec);
+    };
+
+    return timeval(usage.ru_utime) + timeval(usage.ru_stime);
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<std::size_t>
+parseUnsigned(
+    std::string_view str)
 {
-    auto isSpace = [](char c) { return std::isspace(static_cast<unsigned char>(c)); };
+    std::size_t value{0};
+    const auto last = str.data() + str.size();
+    const auto [ptr, ec] = std::from_chars(str.data(), last, value);
 
-    const auto start = std::find_if_not(begin(str), end(str), isSpace);
-    if (start == end(str))
+    if (ec != std::errc{} or ptr != last)
     {
-        return {};
+        return std::nullopt;
     }
 
-    const auto finish = std::find_if_not(rbegin(str), rend(str), isSpace);
-    return str.substr(start - begin(str), finish.base() - start);
+    return value;
 }
 
 //-------------------------------------------------------------------------
@@ -87,29 +143,57 @@ trim(
 ArgonOneUpLidMonitor::ArgonOneUpLidMonitor(
     std::atomic<bool>* run)
 :
-    m_hostname(getHostname()),
+    m_logger{},
+    m_children{},
+    m_configuration{std::make_shared<const Configuration>()},
+    m_controlSocketPath{},
+    m_debouncePeriod{20},
+    m_eventBufferSize{16},
+    m_gpioChip{},
+    m_gpioLine{},
+    m_events{},
+    m_history{},
+    m_historyPath{c_historyPath},
+    m_inputs{},
+    m_lidGpio{},
+    m_lidState{LidState::UNKNOWN},
+    m_lines{},
+    m_eventSource{},
+    m_lastGlobalSeqno{0},
+    m_metrics{},
+    m_metricsExporter{std::filesystem::path{}},
+    m_metricsFailed{false},
+    m_powerSaveSettings{0},
+    m_powerSaver{},
     m_programName(),
+    m_realtime{},
+    m_replayPath{},
     m_run(run),
-    m_shutdownCommand("shutdown -h now"),
-    m_shutdownThread{}
-{
-}
-
-//-------------------------------------------------------------------------
-
-ArgonOneUpLidMonitor::LidState
-ArgonOneUpLidMonitor::eventTypeToLidState(
-    gpiod::edge_event::event_type eventType)
+    m_shutdownAction{},
+    m_shutdownCommandSet{false},
+    m_shutdownDeadline{0},
+    m_signalFd{},
+    m_startupTrace{false},
+    m_timers{},
+    m_shutdownTimer{},
+    m_debounceTimer{m_timers.add(std::bind_front(&ArgonOneUpLidMonitor::resyncLines, this))},
+    m_metricsTimer{m_timers.add(std::bind_front(&ArgonOneUpLidMonitor::writeMetrics, this))},
+    m_watchdogTimer{m_timers.add(std::bind_front(&ArgonOneUpLidMonitor::watchdog, this))},
+    m_watchdogInterval{0},
+    m_tiers{},
+    m_pipeline{},
+    m_nextTier{0},
+    m_countdownActive{false},
+    m_countdownWaiting{false},
+    m_closedAt{0},
+    m_wakeAlarm{false},
+    m_countdownTimers{},
+    m_countdownRecord{},
+    m_resumeCountdown{},
+    m_snapshot{},
+    m_deadlineOffset{0},
+    m_reply{}
 {
-    switch (eventType)
-    {
-        case gpiod::edge_event::event_type::RISING_EDGE:
-            return LidState::OPEN;
-        case gpiod::edge_event::event_type::FALLING_EDGE:
-            return LidState::CLOSED;
-        default:
-            return LidState::UNKNOWN;
-    }
 }
 
 //-------------------------------------------------------------------------
@@ -131,378 +215,2107 @@ ArgonOneUpLidMonitor::valueTypeToLidState(
 
 //-------------------------------------------------------------------------
 
-void
-ArgonOneUpLidMonitor::createShutdownThread()
+sigset_t
+ArgonOneUpLidMonitor::handledSignals()
 {
-    if (not m_shutdownThread.joinable())
+    sigset_t signals;
+    sigemptyset(&signals);
+
+    for (auto signal : { SIGINT, SIGTERM, SIGHUP, SIGUSR1, SIGCHLD })
     {
-        auto function = std::bind_front(&ArgonOneUpLidMonitor::shutdownTimer, this);
-        m_shutdownThread = std::jthread(function);
+        sigaddset(&signals, signal);
     }
+
+    return signals;
 }
 
 //-------------------------------------------------------------------------
 
 void
-ArgonOneUpLidMonitor::destroyShutdownThread()
+ArgonOneUpLidMonitor::armNextTier()
 {
-    if (m_shutdownThread.joinable())
+    // Only the next step of the pipeline has a timer armed, so cancelling
+    // the whole countdown is a single cancel.
+
+    if (m_nextTier >= m_pipeline.size())
     {
-        m_shutdownThread.request_stop();
-        m_shutdownThread.join();
+        m_countdownActive = false;
+        return;
     }
+
+    m_shutdownDeadline = m_closedAt + m_pipeline[m_nextTier].delay;
+    m_countdownTimers->arm(
+        m_shutdownTimer,
+        std::max(m_shutdownDeadline - m_countdownTimers->now(), 0ns));
 }
 
 //-------------------------------------------------------------------------
 
-std::string
-ArgonOneUpLidMonitor::getHostname()
+void
+ArgonOneUpLidMonitor::armShutdownTimer()
 {
-    char hostname[256];
-    if (::gethostname(hostname, sizeof(hostname)) == 0)
-    {
-        return hostname;
-    }
-    else
+    if (m_countdownActive)
     {
-        perrorLog("cannot get hostname");
-        return "localhost";
+        return;
     }
-}
 
-//-------------------------------------------------------------------------
-
-std::chrono::seconds
-ArgonOneUpLidMonitor::getShutdownTimeout()
-{
-    std::filesystem::path config("/etc/argononeupd.conf");
+    m_closedAt = m_countdownTimers->now();
+    m_nextTier = 0;
 
-    if (not std::filesystem::exists(config))
-    {
-        messageLog(
-            LOG_INFO,
-            std::format(
-                "config file \"{}\" does not exist",
-                config.c_str()));
+    buildPipeline();
 
-        return 0s;
-    }
+    // Without any countdown steps, wait for a reload that adds some. They
+    // are then timed from when the lid was closed.
 
-    std::ifstream ifs(config);
-    if (not ifs.is_open())
+    if (m_pipeline.empty())
     {
-        messageLog(
-            LOG_INFO,
-            std::format(
-                "Unable to open config file \"{}\"",
-                config.c_str()));
-
-        return 0s;
+        m_countdownWaiting = true;
+        return;
     }
 
-    std::string line;
-    while (std::getline(ifs, line))
-    {
-        line = trim(line);
+    m_countdownActive = true;
+    m_countdownWaiting = false;
 
-        if (line.starts_with("#") || line.empty())
-        {
-            continue;
-        }
+    // Carry on with a countdown from before a restart. Any steps that
+    // became due while the service was down are run straight away.
 
-        const std::regex pattern{R"(\s*lidshutdownsecs\s*=\s*(\d+))"};
-        std::smatch matches;
-        if (std::regex_search(line, matches, pattern))
-        {
-            try
-            {
-                auto timeout = std::stoul(matches[1].str());
-                auto timeoutSeconds = std::chrono::seconds(timeout);
+    const auto resume = std::exchange(m_resumeCountdown, std::nullopt);
 
-                messageLog(
-                    LOG_INFO,
-                    std::format(
-                        "shutdown timeout set to {:%M:%S} minutes:seconds",
-                        timeoutSeconds));
+    if (resume.has_value() and resume->pipelineHash != pipelineHash())
+    {
+        messageLog(LOG_INFO, "countdown steps have changed since the service stopped, starting the countdown again");
+    }
+    else if (resume.has_value() and resume->closedAt <= m_closedAt)
+    {
+        m_closedAt = resume->closedAt;
+        m_nextTier = std::min(resume->nextTier, m_pipeline.size());
 
-                return timeoutSeconds;
-            }
-            catch (const std::exception& e)
-            {
-                messageLog(
-                    LOG_ERR,
-                    std::format("cannot parse shutdown_timeout: {}", e.what()));
-                return 0s;
-            }
-        }
+        messageLog(
+            LOG_INFO,
+            std::format(
+                "resuming countdown, lid has been closed for {:%M:%S} minutes:seconds",
+                std::chrono::duration_cast<std::chrono::seconds>(m_countdownTimers->now() - m_closedAt)));
     }
 
-    return 0s;
+    armNextTier();
+    saveCountdown();
+    countdownArmed();
 }
 
 //-------------------------------------------------------------------------
 
 void
-ArgonOneUpLidMonitor::lidMonitor()
+ArgonOneUpLidMonitor::countdownArmed()
 {
-    messageLog(LOG_INFO, "starting");
-    messageLog(LOG_INFO, std::format("version: {}", c_projectVersion));
-    messageLog(LOG_INFO, std::format("git commmit hash: {}", c_gitCommitHash));
-
-    messageLog(
-        LOG_INFO,
-        std::format("shutdown command is \"{}\"", m_shutdownCommand));
+    const auto remaining = m_closedAt + m_pipeline.back().delay - m_countdownTimers->now();
+    const auto deadline = std::chrono::system_clock::now()
+                        + std::chrono::duration_cast<std::chrono::system_clock::duration>(remaining);
+    const auto deadlineUsec = std::chrono::duration_cast<std::chrono::microseconds>(
+        deadline.time_since_epoch());
 
-    auto shutdownTimeout = getShutdownTimeout();
+    ++m_metrics.shutdownArmed;
+    scheduleMetrics();
 
-    //---------------------------------------------------------------------
+    m_logger.logEvent(
+        LOG_INFO,
+        LogEvent::SHUTDOWN_ARMED,
+        LogFields{ .shutdownDeadlineUsec = static_cast<std::uint64_t>(deadlineUsec.count()) });
+}
 
-    const std::filesystem::path chipPath{"/dev/gpiochip4"};
-    const gpiod::line::offset lineOffset{27};
+//-------------------------------------------------------------------------
 
-    gpiod::chip chip(chipPath);
+void
+ArgonOneUpLidMonitor::buildPipeline()
+{
+    // Merge the shutdown from the configuration file into the tiers from
+    // the command line. Equal delays keep the shutdown last. The pipeline
+    // keeps its capacity so this doesn't allocate after the first time.
 
-    gpiod::line_settings settings;
-    settings.set_direction(gpiod::line::direction::INPUT);
-    settings.set_edge_detection(gpiod::line::edge::BOTH);
-    settings.set_bias(gpiod::line::bias::PULL_UP);
+    m_pipeline.clear();
 
-    auto request = chip.prepare_request();
-    request.add_line_settings(lineOffset, settings);
+    for (const auto& tier : m_tiers)
+    {
+        m_pipeline.push_back(PipelineStep{ tier.delay, &tier.action });
+    }
 
-    auto lineConfig = request.do_request();
+    if (const auto timeout = m_configuration->lidShutdownTimeout; timeout > 0s)
+    {
+        const auto position = std::ranges::upper_bound(m_pipeline, timeout, {}, &PipelineStep::delay);
+        m_pipeline.insert(position, PipelineStep{ timeout, &m_shutdownAction });
+    }
+}
 
-    //---------------------------------------------------------------------
+//-------------------------------------------------------------------------
 
-    const auto value = lineConfig.get_value(lineOffset);
-    auto state = valueTypeToLidState(value);
+void
+ArgonOneUpLidMonitor::disarmShutdownTimer()
+{
+    m_countdownWaiting = false;
 
-    messageLog(LOG_INFO, std::format("lid {}", toString(state)));
+    // Cleared even without a countdown running, as after the last step.
 
-    if (state == LidState::CLOSED and shutdownTimeout > 0s)
+    if (m_countdownRecord.has_value())
     {
-        createShutdownThread();
+        m_countdownRecord->clear();
     }
 
-    //---------------------------------------------------------------------
-
-    while (*m_run)
+    if (m_countdownActive)
     {
-        constexpr auto blocking{-1s};
-        if (lineConfig.wait_edge_events(blocking))
-        {
-            constexpr auto eventsToRead{1};
-            gpiod::edge_event_buffer buffer{eventsToRead};
-            lineConfig.read_edge_events(buffer, eventsToRead);
-            for (const auto& event : buffer)
-            {
-                state = eventTypeToLidState(event.type());
+        stopCountdown();
 
-                messageLog(
-                    LOG_INFO,
-                    std::format("lid {}", toString(state)));
+        ++m_metrics.shutdownCancelled;
+        scheduleMetrics();
 
-                if (state == LidState::CLOSED)
-                {
-                    createShutdownThread();
-                }
-                else if (state == LidState::OPEN)
-                {
-                    destroyShutdownThread();
-                }
-            }
-        }
+        m_logger.logEvent(LOG_INFO, LogEvent::SHUTDOWN_CANCELLED, LogFields{});
     }
-
-    destroyShutdownThread();
 }
 
 //-------------------------------------------------------------------------
 
+// Stop the countdown timer without cancelling the countdown, which is
+// left saved and not counted or logged as cancelled.
+
 void
-ArgonOneUpLidMonitor::messageLog(
-    int priority,
-    std::string_view message) const
+ArgonOneUpLidMonitor::stopCountdown()
 {
-    if (getenv("JOURNAL_STREAM") != nullptr)
+    if (m_countdownActive)
     {
-        std::string messageStr(message);
-        sd_journal_print(priority, "%s", messageStr.c_str());
+        m_countdownTimers->cancel(m_shutdownTimer);
+        m_countdownActive = false;
     }
-    else
+}
+
+//-------------------------------------------------------------------------
+
+std::string_view
+ArgonOneUpLidMonitor::controlRequest(
+    std::string_view request)
+{
+    const auto space = request.find(' ');
+    const auto command = request.substr(0, space);
+    const auto argument = (space == std::string_view::npos) ? std::string_view{} : request.substr(space + 1);
+
+    // Queries are answered from what has already been formatted.
+
+    if (command == "state")
+    {
+        return m_snapshot;
+    }
+
+    if (command == "deadline")
     {
-        const auto now = floor<std::chrono::seconds>(std::chrono::system_clock::now());
-        const auto localTime = std::chrono::current_zone()->to_local(now);
+        return std::string_view(m_snapshot).substr(m_deadlineOffset);
+    }
+
+    if (command == "metrics")
+    {
+        refreshMetrics();
+        return m_metricsExporter.text(m_metrics);
+    }
 
-        std::print(std::cerr, "{:%b %e %T} ", localTime);
-        std::print(std::cerr, "{} ", m_hostname);
-        std::print(std::cerr, "{}[{}]:", m_programName, getpid());
+    messageLog(LOG_INFO, std::format("control request \"{}\"", request));
 
-        const static std::map<int, std::string> priorityMap
+    if (command == "cancel")
+    {
+        if (not m_countdownActive)
         {
-            { LOG_EMERG, "emergency" },
-            { LOG_ALERT, "alert" },
-            { LOG_CRIT, "critical" },
-            { LOG_ERR, "error" },
-            { LOG_WARNING, "warning" },
-            { LOG_NOTICE, "notice" },
-            { LOG_INFO, "info" },
-            { LOG_DEBUG, "debug" }
-        };
+            return "error: no countdown\n";
+        }
+
+        disarmShutdownTimer();
+        notifyStatus();
+        return "ok\n";
+    }
 
-        if (const auto it = priorityMap.find(priority); it != end(priorityMap))
+    if (command == "postpone")
+    {
+        const auto seconds = parseUnsigned(argument);
+        if (not seconds.has_value())
         {
-            std::print(std::cerr, "{}", it->second);
+            return "error: postpone needs a number of seconds\n";
         }
-        else
+
+        if (not m_countdownActive)
         {
-            std::print(std::cerr, "unknown({})", priority);
+            return "error: no countdown\n";
         }
 
-        std::println(std::cerr, ":{}", message);
-    }
-}
+        // Limit how far the countdown can be moved back, in one request or
+        // many, so that the deadline cannot overflow.
 
-//-------------------------------------------------------------------------
+        constexpr std::chrono::seconds maxPostpone{24h};
 
-std::optional<int>
-ArgonOneUpLidMonitor::parseCommandLine(
-    int argc,
-    char* argv[])
-{
-    m_programName = std::filesystem::path(argv[0]).filename().string();
+        if (*seconds > static_cast<std::uint64_t>(maxPostpone.count()) or
+            m_closedAt + std::chrono::seconds(*seconds) > m_countdownTimers->now() + maxPostpone)
+        {
+            return "error: cannot postpone the countdown by more than a day\n";
+        }
 
-    static const char* sopts = "hs:";
-    static option lopts[] =
+        m_closedAt += std::chrono::seconds(*seconds);
+        armNextTier();
+        saveCountdown();
+        notifyStatus();
+        return "ok\n";
+    }
+
+    if (command == "reload")
     {
-        { "help", no_argument, nullptr, 'h' },
-        { "shutdownCommand", required_argument, nullptr, 's' },
-        { nullptr, no_argument, nullptr, 0 }
-    };
+        reload();
+        return "ok\n";
+    }
 
-    int opt{0};
+    if (command == "simulate-close")
+    {
+        updateLidState(LidState::CLOSED);
+        return "ok\n";
+    }
 
-    while ((opt = ::getopt_long(argc, argv, sopts, lopts, nullptr)) != -1)
+    if (command == "simulate-open")
     {
-        switch (opt)
-        {
-        case 'h':
+        updateLidState(LidState::OPEN);
+        return "ok\n";
+    }
 
-            printUsage(std::cout);
-            return EXIT_SUCCESS;
-            break;
+    m_reply = std::format("error: unknown command \"{}\"\n", command);
+    return m_reply;
+}
 
-        case 's':
+//-------------------------------------------------------------------------
 
-            m_shutdownCommand = optarg;
-            break;
+void
+ArgonOneUpLidMonitor::createCountdownTimers()
+{
+    // CLOCK_BOOTTIME_ALARM needs CAP_WAKE_ALARM. Without it, use
+    // CLOCK_BOOTTIME, which still counts the time spent suspended but
+    // cannot wake the system.
 
-        default:
+    if (m_wakeAlarm)
+    {
+        try
+        {
+            m_countdownTimers.emplace(CLOCK_BOOTTIME_ALARM);
+            messageLog(LOG_INFO, "countdown uses CLOCK_BOOTTIME_ALARM");
+        }
+        catch (const std::system_error& e)
+        {
+            messageLog(
+                LOG_WARNING,
+                std::format("cannot use CLOCK_BOOTTIME_ALARM, using CLOCK_BOOTTIME: {}", e.what()));
 
-            printUsage(std::cerr);
-            return EXIT_FAILURE;
-            break;
+            m_countdownTimers.emplace(CLOCK_BOOTTIME);
         }
     }
+    else
+    {
+        m_countdownTimers.emplace(CLOCK_MONOTONIC);
+    }
 
-    return std::nullopt;
+    m_shutdownTimer = m_countdownTimers->add(
+        std::bind_front(&ArgonOneUpLidMonitor::runNextTier, this));
 }
 
 //-------------------------------------------------------------------------
 
 void
-ArgonOneUpLidMonitor::perrorLog(
-    std::string_view s) const
+ArgonOneUpLidMonitor::enableRealtime()
 {
-    if (getenv("JOURNAL_STREAM") != nullptr)
+    // Called once everything has been set up, so that the memory locked
+    // includes all of it. The logger thread has already been started, so
+    // it keeps the normal scheduling policy and cpus.
+
+    if (not m_realtime.enabled())
     {
-        sd_journal_perror(std::string(s).c_str());
+        return;
     }
-    else
+
+    try
     {
-        messageLog(LOG_ERR, std::string(s) + " - " + ::strerror(errno));
+        lockMemory();
+        prefaultStack();
+        messageLog(LOG_INFO, "memory locked");
+    }
+    catch (const std::system_error& e)
+    {
+        messageLog(LOG_WARNING, std::format("cannot lock memory: {}", e.what()));
+    }
+
+    if (m_realtime.priority.has_value())
+    {
+        try
+        {
+            setFifoPriority(*m_realtime.priority);
+            messageLog(LOG_INFO, std::format("SCHED_FIFO priority {}", *m_realtime.priority));
+        }
+        catch (const std::system_error& e)
+        {
+            messageLog(LOG_WARNING, std::format("cannot set SCHED_FIFO priority: {}", e.what()));
+        }
+    }
+
+    if (m_realtime.cpu.has_value())
+    {
+        try
+        {
+            pinToCpu(*m_realtime.cpu);
+            messageLog(LOG_INFO, std::format("pinned to cpu {}", *m_realtime.cpu));
+        }
+        catch (const std::system_error& e)
+        {
+            messageLog(LOG_WARNING, std::format("cannot pin to cpu {}: {}", *m_realtime.cpu, e.what()));
+        }
     }
 }
 
 //-------------------------------------------------------------------------
 
-void
-ArgonOneUpLidMonitor::printUsage(
-    std::ostream& stream) const
+GpioLine
+ArgonOneUpLidMonitor::findLidLine(
+    const std::string& line)
 {
-    std::println(stream, "");
-    std::println(stream, "Usage: {}", m_programName);
-    std::println(stream, "");
-    std::println(stream, "    --help,-h - print usage and exit");
-    std::println(stream, "    --shutdownCommand,-s <command> - command to execute when lid has been closed for the configured number of seconds (default: \"{}\")", m_shutdownCommand);
-    std::println(stream, "");
-    std::println(stream, "Version: {}", c_projectVersion);
-    std::println(stream, "Git commit hash: {}", c_gitCommitHash);
-    std::println(stream, "");
+    const GpioDiscovery discovery{lidChip(), line};
+
+    bool searched{false};
+    const auto lidLine = discovery.resolve(searched);
+
+    if (searched and not discovery.writeCache(lidLine))
+    {
+        perrorLog(std::format("cannot write gpio cache \"{}\"", GpioDiscovery::c_cachePath));
+    }
+
+    messageLog(
+        LOG_INFO,
+        std::format(
+            "lid gpio \"{}\" is line {} of {}{}",
+            line,
+            lidLine.offset,
+            lidLine.chip.string(),
+            searched ? " (found by search)" : ""));
+
+    return lidLine;
 }
 
 //-------------------------------------------------------------------------
 
-std::string
-ArgonOneUpLidMonitor::toString(
-    LidState state)
+MonitoredLine*
+ArgonOneUpLidMonitor::findLine(
+    gpiod::line::offset offset)
 {
-    switch (state)
-    {
-        case LidState::OPEN:
-            return "open";
-        case LidState::CLOSED:
-            return "closed";
-        default:
-            return "unknown";
-    }
+    // There are only ever a few lines, so a linear search is fastest.
+
+    const auto line = std::ranges::find(m_lines, offset, &MonitoredLine::offset);
+
+    return (line == m_lines.end()) ? nullptr : &*line;
 }
 
 //-------------------------------------------------------------------------
 
-void
-ArgonOneUpLidMonitor::shutdownTimer(
-    std::stop_token stopToken)
+Configuration
+ArgonOneUpLidMonitor::readConfiguration()
 {
-    const auto timeout = getShutdownTimeout();
+    Configuration configuration;
 
-    if (timeout <= 0s)
+    const FileDescriptor fd{::open(c_configPath.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (not fd.valid())
     {
-        return;
-    }
+        if (errno == ENOENT)
+        {
+            messageLog(
+                LOG_INFO,
+                std::format(
+                    "config file \"{}\" does not exist",
+                    c_configPath.c_str()));
+        }
+        else
+        {
+            messageLog(
+                LOG_INFO,
+                std::format(
+                    "Unable to open config file \"{}\"",
+                    c_configPath.c_str()));
+        }
 
-    /*
-     * The predictate always returns false so the wait_for will always
-     * timeout after the specified duration unless the stop token is
-     * requested.
-     *
-     * Using wait_for as an interruptible sleep to allow the shutdown
-     * to be cancelled if the lid is opened before the timeout expires.
-     * If the shutdown is cancelled then the function returns without
-     * calling the shutdown command. If the shutdown is not cancelled
-     * and the timeout expires then the shutdown command is called.
-     */
+        return configuration;
+    }
 
-    std::mutex mtx;
-    std::condition_variable_any cva;
-    // cppcheck-suppress [localMutex]
-    std::unique_lock lock(mtx);
-    auto predictate = []{ return false; };
+    // Read rather than mapped, since the file can be truncated while it is
+    // being reloaded, which would raise SIGBUS on a mapping. The file is
+    // small, so this is one or two reads.
 
-    cva.wait_for(lock, stopToken, timeout, predictate);
+    std::string text;
+    std::array<char, 4096> buffer;
 
-    if (stopToken.stop_requested())
+    for (;;)
     {
-        messageLog(LOG_INFO, "shutdown cancelled");
-        return;
-    }
+        const auto length = ::read(fd.get(), buffer.data(), buffer.size());
+        if (length == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
 
-    messageLog(
-        LOG_INFO,
-        std::format(
-            "lid has been closed for {:%M:%S} minutes:seconds",
-            timeout));
-    messageLog(LOG_INFO, "calling: " + m_shutdownCommand);
+            perrorLog(std::format("cannot read config file \"{}\"", c_configPath.c_str()));
+            return configuration;
+        }
+
+        if (length == 0)
+        {
+            break;
+        }
 
-    ::system(m_shutdownCommand.c_str());
+        text.append(buffer.data(), static_cast<std::size_t>(length));
+    }
+
+    const auto result = parseConfiguration(text, configuration);
+
+    if (result.invalidLine != 0)
+    {
+        messageLog(
+            LOG_ERR,
+            std::format(
+                "cannot parse line {} of config file \"{}\"",
+                result.invalidLine,
+                c_configPath.c_str()));
+    }
+
+    if (configuration.lidShutdownTimeout > 0s)
+    {
+        messageLog(
+            LOG_INFO,
+            std::format(
+                "shutdown timeout set to {:%M:%S} minutes:seconds",
+                configuration.lidShutdownTimeout));
+    }
+
+    return configuration;
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::handleInput(
+    const InputAction& input,
+    gpiod::line::value value)
+{
+    const auto edge = (value == gpiod::line::value::ACTIVE) ? "rising" : "falling";
+
+    if (not input.triggeredBy(value))
+    {
+        if (m_logger.enabled(LOG_DEBUG))
+        {
+            messageLog(LOG_DEBUG, std::format("{} {} edge", input.label, edge));
+        }
+
+        return;
+    }
+
+    messageLog(
+        LOG_INFO,
+        std::format(
+            "{} {} edge, calling: {} ({})",
+            input.label,
+            edge,
+            input.action.command(),
+            input.action.description()));
+
+    startAction(input.action, std::format("{} action", input.label));
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::handleLineEvents()
+{
+    // Drain every queued edge, a buffer at a time, and only act on the
+    // state each line has settled in once the queue is empty. All of the
+    // lines share one request, so this is the only gpio wakeup.
+
+    auto& source = *m_eventSource;
+    std::size_t edges{0};
+    std::size_t suppressed{0};
+    std::size_t count{0};
+    std::uint64_t missed{0};
+
+    do
+    {
+        count = source.read(m_events);
+        edges += count;
+
+        const auto dispatched = monotonicNow();
+
+        for (const auto& event : std::span(m_events).first(count))
+        {
+            m_metrics.dispatchLatency.record(dispatched - std::chrono::nanoseconds(event.timestampNs));
+
+            // The kernel numbers the edges of every line in the request,
+            // starting at one. A gap means the kernel's event buffer
+            // overflowed and edges were dropped. The dropped edge may have
+            // been on any line, and may have been its last, so the only
+            // way to recover is to read every line again.
+
+            const auto globalSeqno = event.globalSeqno;
+            if (globalSeqno > m_lastGlobalSeqno + 1)
+            {
+                missed += globalSeqno - m_lastGlobalSeqno - 1;
+                ++m_metrics.edgeGaps;
+            }
+            m_lastGlobalSeqno = globalSeqno;
+
+            auto verdict = EventHistory::Verdict::IGNORED;
+
+            if (auto line = findLine(event.offset); line != nullptr)
+            {
+                if (line->accept(event))
+                {
+                    verdict = EventHistory::Verdict::ACCEPTED;
+                }
+                else
+                {
+                    verdict = EventHistory::Verdict::SUPPRESSED;
+                    ++suppressed;
+                }
+            }
+
+            m_history.recordEdge(event, verdict);
+        }
+    }
+    while (count == m_events.size() and source.wait(0s));
+
+    if (edges > 1 and m_logger.enabled(LOG_DEBUG))
+    {
+        messageLog(
+            LOG_DEBUG,
+            std::format("coalesced {} edges, {} suppressed by debounce", edges, suppressed));
+    }
+
+    // Edges were dropped inside the debounce period, so a line may have
+    // settled in a different state to the last accepted edge. Check it
+    // once the period has passed.
+
+    std::optional<std::chrono::milliseconds> resyncAfter{};
+
+    for (auto& line : m_lines)
+    {
+        if (line.settle())
+        {
+            resyncAfter = std::max(resyncAfter.value_or(0ms), line.debouncePeriod);
+        }
+    }
+
+    if (resyncAfter.has_value())
+    {
+        m_timers.arm(m_debounceTimer, *resyncAfter);
+    }
+
+    if (missed > 0)
+    {
+        m_metrics.edgesMissed += missed;
+        scheduleMetrics();
+
+        messageLog(
+            LOG_WARNING,
+            std::format("{} gpio edges were dropped by the kernel, reading the lines again", missed));
+
+        resyncLines();
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::handleSignal()
+{
+    signalfd_siginfo info{};
+    if (::read(m_signalFd.get(), &info, sizeof(info)) != sizeof(info))
+    {
+        return;
+    }
+
+    switch (info.ssi_signo)
+    {
+    case SIGINT:
+    case SIGTERM:
+
+        *m_run = false;
+        break;
+
+    case SIGHUP:
+
+        messageLog(LOG_INFO, "SIGHUP received, reloading");
+        reload();
+        break;
+
+    case SIGCHLD:
+
+        reapChildren();
+        break;
+
+    case SIGUSR1:
+
+        logLatency();
+        logHistory();
+        logUsage();
+        break;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::lidMonitor()
+{
+    StartupTrace trace{m_startupTrace};
+
+    m_logger.start();
+
+    messageLog(LOG_INFO, "starting");
+    messageLog(LOG_INFO, std::format("version: {}", c_projectVersion));
+    messageLog(LOG_INFO, std::format("git commmit hash: {}", c_gitCommitHash));
+    trace.mark("logger");
+
+    // The lid may be closed while the system is still booting, so read the
+    // lid switch before anything that is not needed to find it. The line
+    // is requested with the command line settings, or the defaults and the
+    // cache in /run, before the configuration file is read. Only if the
+    // file names another line are the lines requested again.
+
+    requestLines();
+    trace.mark("request lines");
+
+    m_logger.logEvent(
+        LOG_INFO,
+        LogEvent::LID_STATE,
+        LogFields{ .lidState = toString(m_lidState) });
+
+    loadConfiguration();
+    trace.mark("configuration");
+
+    if (lidLineMoved())
+    {
+        messageLog(LOG_INFO, "configuration file names another lid gpio line, requesting the lines again");
+
+        m_eventSource.reset();
+        requestLines();
+        trace.mark("request lines again");
+
+        m_logger.logEvent(
+            LOG_INFO,
+            LogEvent::LID_STATE,
+            LogFields{ .lidState = toString(m_lidState) });
+    }
+
+    m_events.resize(m_eventBufferSize);
+
+    try
+    {
+        updateShutdownAction();
+    }
+    catch (const std::exception& e)
+    {
+        messageLog(LOG_WARNING, std::format("shutdown command: {}", e.what()));
+    }
+
+    //---------------------------------------------------------------------
+
+    messageLog(
+        LOG_INFO,
+        std::format(
+            "shutdown command is \"{}\" ({})",
+            m_shutdownAction.command(),
+            m_shutdownAction.description()));
+
+    for (const auto& tier : m_tiers)
+    {
+        messageLog(
+            LOG_INFO,
+            std::format(
+                "after {:%M:%S} minutes:seconds will call \"{}\" ({})",
+                tier.delay,
+                tier.action.command(),
+                tier.action.description()));
+    }
+
+    m_pipeline.reserve(m_tiers.size() + 1);
+    createCountdownTimers();
+    openCountdownRecord();
+    trace.mark("countdown");
+
+    try
+    {
+        m_shutdownAction.connect();
+
+        for (auto& tier : m_tiers)
+        {
+            tier.action.connect();
+        }
+
+        for (auto& input : m_inputs)
+        {
+            input.action.connect();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        messageLog(
+            LOG_WARNING,
+            std::format("cannot connect to logind, will run command: {}", e.what()));
+    }
+
+    trace.mark("logind");
+
+    if (m_powerSaveSettings != 0)
+    {
+        m_powerSaver = PowerSaver{m_powerSaveSettings, m_realtime.cpu};
+        messageLog(LOG_INFO, std::format("power save controls {} sysfs files", m_powerSaver.size()));
+        trace.mark("power save");
+    }
+
+    //---------------------------------------------------------------------
+
+    const auto signals = handledSignals();
+    m_signalFd = FileDescriptor{::signalfd(-1, &signals, SFD_NONBLOCK | SFD_CLOEXEC)};
+    if (not m_signalFd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), "signalfd");
+    }
+
+    EventLoop eventLoop;
+
+    eventLoop.add(
+        m_eventSource->fd(),
+        EPOLLIN,
+        [this](std::uint32_t) { handleLineEvents(); });
+    eventLoop.add(
+        m_signalFd.get(),
+        EPOLLIN,
+        [this](std::uint32_t) { handleSignal(); });
+    eventLoop.add(
+        m_timers.fd(),
+        EPOLLIN,
+        [this](std::uint32_t) { m_timers.dispatch(); });
+    eventLoop.add(
+        m_countdownTimers->fd(),
+        EPOLLIN,
+        [this](std::uint32_t) { m_countdownTimers->dispatch(); });
+
+    FileWatcher configWatcher{c_configPath};
+
+    eventLoop.add(
+        configWatcher.fd(),
+        EPOLLIN,
+        [this, &configWatcher](std::uint32_t)
+        {
+            if (configWatcher.changed())
+            {
+                reload();
+            }
+        });
+
+    std::optional<ControlSocket> controlSocket;
+
+    try
+    {
+        controlSocket.emplace(
+            eventLoop,
+            m_controlSocketPath,
+            std::bind_front(&ArgonOneUpLidMonitor::controlRequest, this));
+
+        if (controlSocket->activated())
+        {
+            messageLog(LOG_INFO, "control socket passed by systemd");
+        }
+        else if (controlSocket->enabled())
+        {
+            messageLog(LOG_INFO, std::format("control socket \"{}\"", m_controlSocketPath.string()));
+        }
+    }
+    catch (const std::system_error& e)
+    {
+        messageLog(LOG_WARNING, std::format("cannot create control socket: {}", e.what()));
+    }
+
+    trace.mark("event loop");
+
+    if (m_lidState == LidState::CLOSED)
+    {
+        armShutdownTimer();
+        savePower();
+    }
+    else if (m_countdownRecord.has_value())
+    {
+        m_countdownRecord->clear();
+    }
+
+    m_resumeCountdown.reset();
+    writeMetrics();
+    trace.mark("arm countdown");
+
+    //---------------------------------------------------------------------
+
+    // The watchdog is pinged from a timer in the event loop, so a hung
+    // loop stops the pings.
+
+    if (std::uint64_t usec{0}; sd_watchdog_enabled(0, &usec) > 0)
+    {
+        m_watchdogInterval = std::chrono::microseconds(usec / 2);
+        watchdog();
+    }
+
+    enableRealtime();
+    trace.mark("realtime");
+
+    sd_notify(0, "READY=1");
+    notifyStatus();
+    trace.mark("ready");
+    trace.log(m_logger);
+
+    //---------------------------------------------------------------------
+
+    // Nothing is polled, so while the lid and the configuration are left
+    // alone the only wakeups are the watchdog, if enabled.
+
+    while (*m_run)
+    {
+        eventLoop.wait();
+        ++m_metrics.wakeups;
+    }
+
+    sd_notify(0, "STOPPING=1");
+
+    // Keep the saved countdown, so that it carries on if the service is
+    // started again while the lid is still closed.
+
+    stopCountdown();
+    restorePower();
+
+    for (const auto& line : m_lines)
+    {
+        if (line.debouncer.enabled())
+        {
+            messageLog(
+                LOG_INFO,
+                std::format("{} debounce suppressed {} edges", line.label, line.debouncer.suppressed()));
+        }
+    }
+
+    logLatency();
+    writeMetrics();
+}
+
+//-------------------------------------------------------------------------
+
+std::filesystem::path
+ArgonOneUpLidMonitor::lidChip() const
+{
+    // The command line overrides the configuration file. If neither gives
+    // a chip, the line is looked for in the cache or searched for.
+
+    if (not m_gpioChip.empty())
+    {
+        return m_gpioChip;
+    }
+
+    return m_configuration->gpioChip;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+ArgonOneUpLidMonitor::lidLineMoved() const
+{
+    // Only a line or chip named by the configuration file, and not given
+    // on the command line, can differ from the line requested.
+
+    const bool lineNamed = m_gpioLine.empty() and not m_configuration->gpioLine.empty();
+    const bool chipNamed = m_gpioChip.empty() and not m_configuration->gpioChip.empty();
+
+    if (not m_replayPath.empty())
+    {
+        return lineNamed and lidLineName() != std::to_string(m_lidGpio.offset);
+    }
+
+    if (not lineNamed and not chipNamed)
+    {
+        return false;
+    }
+
+    bool searched{false};
+    const auto lidLine = GpioDiscovery{lidChip(), lidLineName()}.resolve(searched);
+
+    return lidLine.chip != m_lidGpio.chip or lidLine.offset != m_lidGpio.offset;
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+ArgonOneUpLidMonitor::lidLineName() const
+{
+    // The command line overrides the configuration file, which overrides
+    // the default.
+
+    if (not m_gpioLine.empty())
+    {
+        return m_gpioLine;
+    }
+
+    if (not m_configuration->gpioLine.empty())
+    {
+        return m_configuration->gpioLine;
+    }
+
+    return std::string(GpioDiscovery::c_defaultLine);
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::loadConfiguration()
+{
+    // Readers always see a complete snapshot. The snapshot is only
+    // replaced here, never modified.
+
+    m_configuration = std::make_shared<const Configuration>(readConfiguration());
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::logHistory() const
+{
+    messageLog(
+        LOG_INFO,
+        std::format("last {} edges and lid events, oldest first:", m_history.size()));
+
+    for (std::size_t i = 0 ; i < m_history.size() ; ++i)
+    {
+        messageLog(LOG_INFO, EventHistory::describe(m_history.at(i)));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::logLatency() const
+{
+    messageLog(
+        LOG_INFO,
+        std::format("edge dispatch latency: {}", m_metrics.dispatchLatency.summary()));
+    messageLog(
+        LOG_INFO,
+        std::format("lid closed to shutdown armed latency: {}", m_metrics.armLatency.summary()));
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::logUsage()
+{
+    refreshMetrics();
+
+    messageLog(
+        LOG_INFO,
+        std::format(
+            "usage: {} wakeups, system calls gpio {} log {} timer {} spawn {}, cpu main {:.3f}s logger {:.3f}s",
+            m_metrics.wakeups,
+            m_metrics.gpioSyscalls,
+            m_metrics.logSyscalls,
+            m_metrics.timerSyscalls,
+            m_metrics.spawnSyscalls,
+            std::chrono::duration<double>(m_metrics.mainCpu).count(),
+            std::chrono::duration<double>(m_metrics.loggerCpu).count()));
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::messageLog(
+    int priority,
+    std::string_view message) const
+{
+    m_logger.log(priority, message);
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::notifyStatus()
+{
+    // Called whenever the lid state or the countdown changes. Updates the
+    // systemd status and the control socket snapshot, which reuses its
+    // buffer.
+
+    std::string status;
+
+    m_snapshot.clear();
+    auto out = std::back_inserter(m_snapshot);
+
+    std::format_to(out, "lid={}\n", toString(m_lidState));
+    m_deadlineOffset = m_snapshot.size();
+
+    if (m_countdownActive and m_nextTier < m_pipeline.size())
+    {
+        const auto& step = m_pipeline[m_nextTier];
+        const auto now = m_countdownTimers->now();
+        const auto remaining = std::chrono::ceil<std::chrono::seconds>(
+            std::max(m_shutdownDeadline - now, 0ns));
+
+        status = std::format(
+            "STATUS=lid {}, calling \"{}\" in {:%M:%S}, {} wakeups",
+            toString(m_lidState),
+            step.action->command(),
+            remaining,
+            m_metrics.wakeups);
+
+        const auto toRealtimeUsec = [now](std::chrono::nanoseconds deadline)
+        {
+            const auto when = std::chrono::system_clock::now().time_since_epoch() + (deadline - now);
+            return std::chrono::duration_cast<std::chrono::microseconds>(when).count();
+        };
+
+        std::format_to(
+            out,
+            "countdown=active\n"
+            "next_action={}\n"
+            "next_action_usec={}\n"
+            "last_action_usec={}\n",
+            step.action->command(),
+            toRealtimeUsec(m_shutdownDeadline),
+            toRealtimeUsec(m_closedAt + m_pipeline.back().delay));
+    }
+    else
+    {
+        status = std::format("STATUS=lid {}, {} wakeups", toString(m_lidState), m_metrics.wakeups);
+        std::format_to(out, "countdown=inactive\n");
+    }
+
+    sd_notify(0, status.c_str());
+}
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::openCountdownRecord()
+{
+    try
+    {
+        m_countdownRecord.emplace();
+    }
+    catch (const std::system_error& e)
+    {
+        messageLog(
+            LOG_WARNING,
+            std::format(
+                "cannot open \"{}\", the countdown will restart with the service: {}",
+                CountdownRecord::c_path,
+                e.what()));
+        return;
+    }
+
+    // A countdown timed with a different clock can't be carried on.
+
+    if (auto state = m_countdownRecord->load();
+        state.has_value() and state->clock == m_countdownTimers->clock())
+    {
+        m_resumeCountdown = state;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<int>
+ArgonOneUpLidMonitor::parseCommandLine(
+    int argc,
+    char* argv[])
+{
+    m_programName = std::filesystem::path(argv[0]).filename().string();
+    m_logger.setIdentity({}, m_programName);
+
+    static const char* sopts = "a:b:c:C:d:hH:i:k:l:m:p:r:R:s:S:Tvw";
+    static option lopts[] =
+    {
+        { "action", required_argument, nullptr, 'a' },
+        { "chip", required_argument, nullptr, 'c' },
+        { "controlSocket", required_argument, nullptr, 'k' },
+        { "cpu", required_argument, nullptr, 'C' },
+        { "debounce", required_argument, nullptr, 'd' },
+        { "eventBufferSize", required_argument, nullptr, 'b' },
+        { "help", no_argument, nullptr, 'h' },
+        { "historyFile", required_argument, nullptr, 'H' },
+        { "input", required_argument, nullptr, 'i' },
+        { "line", required_argument, nullptr, 'l' },
+        { "metricsFile", required_argument, nullptr, 'm' },
+        { "powerSave", required_argument, nullptr, 'p' },
+        { "realtime", required_argument, nullptr, 'r' },
+        { "replay", required_argument, nullptr, 'R' },
+        { "shutdownCommand", required_argument, nullptr, 's' },
+        { "startupTrace", no_argument, nullptr, 'T' },
+        { "suspendAfter", required_argument, nullptr, 'S' },
+        { "verbose", no_argument, nullptr, 'v' },
+        { "wakeAlarm", no_argument, nullptr, 'w' },
+        { nullptr, no_argument, nullptr, 0 }
+    };
+
+    int opt{0};
+
+    while ((opt = ::getopt_long(argc, argv, sopts, lopts, nullptr)) != -1)
+    {
+        switch (opt)
+        {
+        case 'a':
+
+            if (not parseTier(optarg))
+            {
+                std::println(stderr, "invalid action \"{}\"", optarg);
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+
+            break;
+
+        case 'b':
+
+            if (const auto size = parseUnsigned(optarg); size.has_value() and *size > 0)
+            {
+                m_eventBufferSize = *size;
+            }
+            else
+            {
+                std::println(stderr, "invalid event buffer size \"{}\"", optarg);
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+
+            break;
+
+        case 'c':
+
+            m_gpioChip = optarg;
+            break;
+
+        case 'C':
+
+            if (const auto cpu = parseUnsigned(optarg); cpu.has_value() and *cpu < CPU_SETSIZE)
+            {
+                m_realtime.cpu = static_cast<int>(*cpu);
+            }
+            else
+            {
+                std::println(stderr, "invalid cpu \"{}\"", optarg);
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+
+            break;
+
+        case 'd':
+
+            if (const auto period = parseUnsigned(optarg); period.has_value())
+            {
+                m_debouncePeriod = std::chrono::milliseconds(*period);
+            }
+            else
+            {
+                std::println(stderr, "invalid debounce period \"{}\"", optarg);
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+
+            break;
+
+        case 'h':
+
+            printUsage(stdout);
+            return EXIT_SUCCESS;
+            break;
+
+        case 'H':
+
+            m_historyPath = optarg;
+            break;
+
+        case 'i':
+
+            if (auto input = parseInputAction(optarg); input.has_value())
+            {
+                m_inputs.push_back(std::move(*input));
+            }
+            else
+            {
+                std::println(stderr, "invalid input \"{}\"", optarg);
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+
+            break;
+
+        case 'k':
+
+            m_controlSocketPath = optarg;
+            break;
+
+        case 'l':
+
+            m_gpioLine = optarg;
+            break;
+
+        case 'm':
+
+            m_metricsExporter = MetricsExporter{optarg};
+            break;
+
+        case 'p':
+
+            if (const auto settings = PowerSaver::parse(optarg); settings.has_value())
+            {
+                m_powerSaveSettings = *settings;
+            }
+            else
+            {
+                std::println(stderr, "invalid power save settings \"{}\"", optarg);
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'r':
+
+            if (const auto priority = parseUnsigned(optarg);
+                priority.has_value() and
+                std::cmp_greater_equal(*priority, ::sched_get_priority_min(SCHED_FIFO)) and
+                std::cmp_less_equal(*priority, ::sched_get_priority_max(SCHED_FIFO)))
+            {
+                m_realtime.priority = static_cast<int>(*priority);
+            }
+            else
+            {
+                std::println(stderr, "invalid realtime priority \"{}\"", optarg);
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+
+            break;
+
+        case 'R':
+
+            m_replayPath = optarg;
+            break;
+
+        case 's':
+
+            try
+            {
+                m_shutdownAction = ShutdownAction{optarg};
+                m_shutdownCommandSet = true;
+            }
+            catch (const std::exception& e)
+            {
+                std::println(stderr, "invalid shutdown command \"{}\" : {}", optarg, e.what());
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+            break;
+
+        case 'S':
+
+            if (not parseTier(std::format("{}:systemctl suspend", optarg)))
+            {
+                std::println(stderr, "invalid suspend delay \"{}\"", optarg);
+                printUsage(stderr);
+                return EXIT_FAILURE;
+            }
+
+            m_wakeAlarm = true;
+            break;
+
+        case 'T':
+
+            m_startupTrace = true;
+            break;
+
+        case 'v':
+
+            m_logger.setMaxPriority(LOG_DEBUG);
+            break;
+
+        case 'w':
+
+            m_wakeAlarm = true;
+            break;
+
+        default:
+
+            printUsage(stderr);
+            return EXIT_FAILURE;
+            break;
+        }
+    }
+
+    return std::nullopt;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+ArgonOneUpLidMonitor::parseTier(
+    std::string_view tier)
+{
+    const auto colon = tier.find(':');
+    if (colon == std::string_view::npos)
+    {
+        return false;
+    }
+
+    const auto seconds = parseUnsigned(tier.substr(0, colon));
+    if (not seconds.has_value())
+    {
+        return false;
+    }
+
+    try
+    {
+        ActionTier actionTier{
+            std::chrono::seconds(*seconds),
+            ShutdownAction{tier.substr(colon + 1)}};
+
+        const auto position = std::ranges::upper_bound(
+            m_tiers,
+            actionTier.delay,
+            {},
+            &ActionTier::delay);
+        m_tiers.insert(position, std::move(actionTier));
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::perrorLog(
+    std::string_view s) const
+{
+    messageLog(LOG_ERR, std::string(s) + " - " + ::strerror(errno));
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::prepareReplay()
+{
+    if (m_replayPath.empty())
+    {
+        throw std::runtime_error("prepareReplay needs a --replay trace");
+    }
+
+    requestLines();
+    m_events.resize(m_eventBufferSize);
+
+    if (not m_countdownTimers.has_value())
+    {
+        createCountdownTimers();
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::uint64_t
+ArgonOneUpLidMonitor::pipelineHash() const
+{
+    // FNV-1a over the delay and command of each step.
+
+    std::uint64_t hash{0xcbf29ce484222325};
+
+    const auto add = [&hash](std::string_view bytes)
+    {
+        for (const auto byte : bytes)
+        {
+            hash = (hash ^ static_cast<unsigned char>(byte)) * 0x100000001b3;
+        }
+    };
+
+    for (const auto& step : m_pipeline)
+    {
+        const auto delay = step.delay.count();
+        add(std::string_view(reinterpret_cast<const char*>(&delay), sizeof(delay)));
+        add(step.action->command());
+        add(std::string_view("", 1));
+    }
+
+    return hash;
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::printUsage(
+    std::FILE* stream) const
+{
+    std::println(stream, "");
+    std::println(stream, "Usage: {}", m_programName);
+    std::println(stream, "");
+    std::println(stream, "    --action,-a <seconds>:<command> - also call command when lid has been closed for seconds, may be repeated");
+    std::println(stream, "    --chip,-c <path> - gpio chip the lid switch is connected to (default: search for the line)");
+    std::println(stream, "    --controlSocket,-k <path> - serve state queries and commands on a unix socket at path (default: only if socket activated)");
+    std::println(stream, "    --cpu,-C <cpu> - pin the event loop to this cpu (default: any)");
+    std::println(stream, "    --debounce,-d <milliseconds> - lid switch debounce period, 0 to disable (default: {})", m_debouncePeriod.count());
+    std::println(stream, "    --eventBufferSize,-b <events> - number of gpio edge events read in one batch (default: {})", m_eventBufferSize);
+    std::println(stream, "    --help,-h - print usage and exit");
+    std::println(stream, "    --historyFile,-H <path> - save the recent edge history here before each countdown action, empty to disable (default: {})", c_historyPath.string());
+    std::println(stream, "    --input,-i <label>:<line>:<edge>[,bias=<bias>][,debounce=<milliseconds>]:<command> - also call command on a rising, falling or both edges of another line on the same chip, with a pull-up (default), pull-down, disabled or as-is bias and its own debounce period (default: the lid switch's), may be repeated");
+    std::println(stream, "    --line,-l <name|offset> - gpio line the lid switch is connected to (default: {})", GpioDiscovery::c_defaultLine);
+    std::println(stream, "    --metricsFile,-m <path> - write Prometheus metrics to this file for the node_exporter textfile collector (default: disabled)");
+    std::println(stream, "    --powerSave,-p <governor,cpus,usb,hdmi|all> - while the lid is closed use the powersave cpufreq governor, take the secondary cpus offline, runtime suspend USB and turn off HDMI (default: disabled)");
+    std::println(stream, "    --realtime,-r <priority> - run the event loop SCHED_FIFO at this priority with memory locked (default: disabled)");
+    std::println(stream, "    --replay,-R <trace> - replay the edges in a trace file instead of reading the gpio lines, which must be given as offsets");
+    std::println(stream, "    --shutdownCommand,-s <command> - command to execute when lid has been closed for the configured number of seconds (default: \"{}\")", m_shutdownAction.command());
+    std::println(stream, "    --startupTrace,-T - log how long each phase of startup took");
+    std::println(stream, "    --suspendAfter,-S <seconds> - suspend when lid has been closed for seconds, waking for the shutdown (implies --wakeAlarm)");
+    std::println(stream, "    --verbose,-v - also log debug messages, such as every input edge and batch of edges read");
+    std::println(stream, "    --wakeAlarm,-w - time the countdown with CLOCK_BOOTTIME_ALARM so it continues through, and wakes from, suspend");
+    std::println(stream, "");
+    std::println(stream, "Version: {}", c_projectVersion);
+    std::println(stream, "Git commit hash: {}", c_gitCommitHash);
+    std::println(stream, "");
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::recomputeCountdown()
+{
+    // The steps already called stay called, whatever their new delay. The
+    // rest are timed from when the lid was closed, as before, so a timeout
+    // shortened to less than the lid has been closed is due straight away.
+
+    std::vector<const ShutdownAction*> called;
+    for (const auto& step : std::span(m_pipeline).first(m_nextTier))
+    {
+        called.push_back(step.action);
+    }
+
+    buildPipeline();
+
+    const auto pending = std::ranges::stable_partition(
+        m_pipeline,
+        [&called](const PipelineStep& step) { return std::ranges::find(called, step.action) != called.end(); });
+
+    m_nextTier = static_cast<std::size_t>(pending.begin() - m_pipeline.begin());
+
+    // With no steps left the lid is still closed, so wait for a reload
+    // that adds some rather than cancelling the countdown.
+
+    if (m_nextTier >= m_pipeline.size())
+    {
+        messageLog(LOG_INFO, "no countdown steps left after reload");
+        stopCountdown();
+        m_countdownWaiting = true;
+        return;
+    }
+
+    const bool arming = not m_countdownActive;
+
+    m_countdownTimers->cancel(m_shutdownTimer);
+    m_countdownActive = true;
+    m_countdownWaiting = false;
+    armNextTier();
+    saveCountdown();
+
+    messageLog(
+        LOG_INFO,
+        std::format(
+            "countdown recomputed, will call \"{}\" when lid has been closed for {:%M:%S} minutes:seconds",
+            m_pipeline[m_nextTier].action->command(),
+            m_pipeline[m_nextTier].delay));
+
+    if (arming)
+    {
+        countdownArmed();
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::refreshMetrics()
+{
+    m_metrics.debounceSuppressed = 0;
+
+    for (const auto& line : m_lines)
+    {
+        m_metrics.debounceSuppressed += line.debouncer.suppressed();
+    }
+
+    m_metrics.lidState = toString(m_lidState);
+
+    // Called on the event loop thread, so RUSAGE_THREAD is its cpu time.
+
+    m_metrics.gpioSyscalls = m_eventSource ? m_eventSource->syscalls() : 0;
+    m_metrics.logSyscalls = m_logger.writes();
+    m_metrics.logDropped = m_logger.dropped();
+    m_metrics.logTruncated = m_logger.truncated();
+    m_metrics.timerSyscalls = m_timers.syscalls()
+                            + (m_countdownTimers.has_value() ? m_countdownTimers->syscalls() : 0);
+    m_metrics.mainCpu = threadCpuTime();
+    m_metrics.loggerCpu = m_logger.cpuTime();
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::reload()
+{
+    // The new snapshot replaces the old one whole, so the event loop, the
+    // only reader, sees one or the other, and the old one stays valid for
+    // comparison until it goes out of scope.
+
+    sd_notify(0, "RELOADING=1");
+
+    const auto previous = m_configuration;
+    loadConfiguration();
+    const auto& current = *m_configuration;
+
+    if (current.gpioChip != previous->gpioChip or current.gpioLine != previous->gpioLine)
+    {
+        messageLog(LOG_WARNING, "the lid gpio line is only changed by restarting");
+    }
+
+    try
+    {
+        if (updateShutdownAction())
+        {
+            messageLog(
+                LOG_INFO,
+                std::format(
+                    "shutdown command is now \"{}\" ({})",
+                    m_shutdownAction.command(),
+                    m_shutdownAction.description()));
+
+            m_shutdownAction.connect();
+        }
+    }
+    catch (const std::exception& e)
+    {
+        messageLog(LOG_WARNING, std::format("shutdown command: {}", e.what()));
+    }
+
+    if (current.lidShutdownTimeout != previous->lidShutdownTimeout and
+        (m_countdownActive or m_countdownWaiting))
+    {
+        recomputeCountdown();
+    }
+
+    sd_notify(0, "READY=1");
+    notifyStatus();
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::requestLines()
+{
+    // When replaying a trace there is no chip to look the lines up on, so
+    // they must be given as offsets.
+
+    const bool replay = not m_replayPath.empty();
+    std::optional<gpiod::chip> chip;
+
+    const auto replayOffset = [](const std::string& line)
+    {
+        if (const auto offset = parseUnsigned(line); offset.has_value())
+        {
+            return static_cast<gpiod::line::offset>(*offset);
+        }
+
+        throw std::runtime_error(
+            std::format("gpio line \"{}\" must be an offset to replay a trace", line));
+    };
+
+    const auto lidLine = replay ? GpioLine{ {}, replayOffset(lidLineName()) } : findLidLine(lidLineName());
+    m_lidGpio = lidLine;
+
+    if (not replay)
+    {
+        chip.emplace(lidLine.chip);
+    }
+
+    // The inputs are on the same chip as the lid switch, so that every
+    // line can be served by one request.
+
+    m_lines.clear();
+    m_lines.reserve(m_inputs.size() + 1);
+
+    m_lines.push_back(
+        MonitoredLine{
+            .label = "lid",
+            .offset = lidLine.offset,
+            .debouncePeriod = m_debouncePeriod,
+            .handler = [this](gpiod::line::value value, std::uint64_t timestampNs, std::uint64_t lineSeqno)
+            {
+                updateLidState(valueTypeToLidState(value), timestampNs, lineSeqno);
+            } });
+
+    for (const auto& input : m_inputs)
+    {
+        bool searched{false};
+        const auto offset = replay
+                          ? replayOffset(input.line)
+                          : GpioDiscovery{lidLine.chip, input.line}.resolve(searched).offset;
+
+        if (findLine(offset) != nullptr)
+        {
+            throw std::runtime_error(
+                std::format("gpio line \"{}\" is already monitored", input.line));
+        }
+
+        messageLog(
+            LOG_INFO,
+            std::format(
+                "{} gpio \"{}\" is line {}, bias {}, on {} edge will call \"{}\" ({})",
+                input.label,
+                input.line,
+                offset,
+                input.biasName(),
+                input.edgeName(),
+                input.action.command(),
+                input.action.description()));
+
+        m_lines.push_back(
+            MonitoredLine{
+                .label = input.label,
+                .offset = offset,
+                .bias = input.bias,
+                .debouncePeriod = input.debouncePeriod.value_or(m_debouncePeriod),
+                .handler = [this, &input](gpiod::line::value value, std::uint64_t, std::uint64_t)
+                {
+                    handleInput(input, value);
+                } });
+    }
+
+    //---------------------------------------------------------------------
+
+    if (replay)
+    {
+        auto source = std::make_unique<ReplayEventSource>(m_replayPath);
+
+        messageLog(
+            LOG_INFO,
+            std::format("replaying {} edges from \"{}\"", source->size(), m_replayPath.string()));
+
+        m_eventSource = std::move(source);
+    }
+    else
+    {
+        // The kernel's edge event FIFO is left at its default depth of 16
+        // events for each line requested. The batch size only sets how
+        // many are read from it at once.
+
+        gpiod::request_config requestConfig;
+        requestConfig.set_consumer(m_programName);
+
+        auto request = chip->prepare_request();
+        request.set_request_config(requestConfig);
+
+        for (const auto& line : m_lines)
+        {
+            request.add_line_settings(line.offset, line.settings());
+        }
+
+        m_eventSource = std::make_unique<GpiodEventSource>(request.do_request(), m_eventBufferSize);
+    }
+
+    // Read the starting values straight after the request, before looking
+    // up the debounce periods, so the starting lid state is as early as it
+    // can be.
+
+    for (auto& line : m_lines)
+    {
+        line.value = m_eventSource->value(line.offset);
+    }
+
+    m_lidState = valueTypeToLidState(m_lines.front().value);
+
+    //---------------------------------------------------------------------
+
+    // The kernel reports the debounce period it applied to each line. If
+    // it could not apply the requested period, fall back to debouncing
+    // using the edge event timestamps. A trace has the edges before any
+    // kernel debounce, so is always debounced in software.
+
+    for (auto& line : m_lines)
+    {
+        const auto kernelDebounce = chip.has_value()
+                                  ? chip->get_line_info(line.offset).debounce_period()
+                                  : 0us;
+
+        if (line.debouncePeriod == 0ms)
+        {
+            messageLog(LOG_INFO, std::format("{} debounce disabled", line.label));
+        }
+        else if (kernelDebounce >= line.debouncePeriod)
+        {
+            messageLog(
+                LOG_INFO,
+                std::format("{} kernel debounce period {}", line.label, kernelDebounce));
+        }
+        else
+        {
+            line.debouncer = Debouncer{line.debouncePeriod};
+
+            messageLog(
+                LOG_INFO,
+                std::format("{} software debounce period {}", line.label, line.debouncePeriod));
+        }
+
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::restorePower()
+{
+    if (not m_powerSaver.saving())
+    {
+        return;
+    }
+
+    const auto result = m_powerSaver.restore();
+
+    messageLog(
+        (result.failed == 0) ? LOG_INFO : LOG_WARNING,
+        std::format(
+            "power save restored {} sysfs files, {} failed, in {:.0f}us",
+            result.changed,
+            result.failed,
+            std::chrono::duration<double, std::micro>(result.took).count()));
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::reapChildren()
+{
+    // Signals are coalesced, so one SIGCHLD may be for several children.
+
+    int status{0};
+    pid_t pid{0};
+
+    while ((pid = ::waitpid(-1, &status, WNOHANG)) > 0)
+    {
+        const auto child = std::ranges::find(m_children, pid, &Child::pid);
+        const auto label = (child != m_children.end()) ? child->label : std::format("child {}", pid);
+
+        if (WIFEXITED(status))
+        {
+            messageLog(
+                (WEXITSTATUS(status) == 0) ? LOG_INFO : LOG_WARNING,
+                std::format("{} exited with status {}", label, WEXITSTATUS(status)));
+        }
+        else if (WIFSIGNALED(status))
+        {
+            messageLog(
+                LOG_WARNING,
+                std::format("{} killed by signal {}", label, ::strsignal(WTERMSIG(status))));
+        }
+
+        if (child != m_children.end())
+        {
+            m_children.erase(child);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::resyncLines()
+{
+    for (auto& line : m_lines)
+    {
+        line.update(m_eventSource->value(line.offset));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::savePower()
+{
+    if (not m_powerSaver.enabled())
+    {
+        return;
+    }
+
+    const auto result = m_powerSaver.save();
+
+    messageLog(
+        (result.failed == 0) ? LOG_INFO : LOG_WARNING,
+        std::format(
+            "power save changed {} sysfs files, {} failed, in {:.0f}us",
+            result.changed,
+            result.failed,
+            std::chrono::duration<double, std::micro>(result.took).count()));
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::saveCountdown()
+{
+    if (m_countdownRecord.has_value())
+    {
+        m_countdownRecord->save(
+            CountdownRecord::State{
+                m_countdownTimers->clock(),
+                m_closedAt,
+                m_nextTier,
+                pipelineHash() });
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::scheduleMetrics()
+{
+    // Changes are coalesced so that a burst of events results in a single
+    // write, and nothing is written while nothing changes.
+
+    constexpr auto metricsDelay{100ms};
+
+    if (m_metricsExporter.enabled() and not m_timers.armed(m_metricsTimer))
+    {
+        m_timers.arm(m_metricsTimer, metricsDelay);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::runNextTier()
+{
+    const auto step = m_pipeline[m_nextTier++];
+    const auto& action = *step.action;
+    const auto late = m_countdownTimers->now() - m_shutdownDeadline;
+
+    // Arm the next step before starting this one, so that a slow command
+    // cannot delay it. The steps are timed from the lid closing, not from
+    // each other.
+
+    armNextTier();
+
+    // Only the last step ends the countdown. There is nothing left to carry
+    // on with after a restart, but a reload can still add a later step.
+
+    if (m_nextTier == m_pipeline.size())
+    {
+        ++m_metrics.shutdownFired;
+        m_countdownWaiting = true;
+
+        if (m_countdownRecord.has_value())
+        {
+            m_countdownRecord->clear();
+        }
+    }
+    else
+    {
+        saveCountdown();
+    }
+
+    writeMetrics();
+
+    messageLog(
+        LOG_INFO,
+        std::format(
+            "lid has been closed for {:%M:%S} minutes:seconds",
+            step.delay));
+
+    messageLog(
+        LOG_INFO,
+        std::format(
+            "calling: {} ({}), {:.3f}ms after timer expiry",
+            action.command(),
+            action.description(),
+            std::chrono::duration<double, std::milli>(late).count()));
+
+    // The action may well stop this process, so save what led up to it.
+
+    m_history.recordAction(m_nextTier - 1, static_cast<std::uint64_t>(monotonicNow().count()));
+
+    if (not m_historyPath.empty() and not m_history.write(m_historyPath))
+    {
+        perrorLog(std::format("cannot write history file \"{}\"", m_historyPath.string()));
+    }
+
+    startAction(action, "shutdown action");
+    notifyStatus();
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::startAction(
+    const ShutdownAction& action,
+    std::string_view label)
+{
+    // A command is not waited for here. It is reaped when SIGCHLD arrives,
+    // so the event loop carries on while it runs.
+
+    ++m_metrics.spawnSyscalls;
+
+    try
+    {
+        const auto started = action.run();
+
+        if (not started.logindError.empty())
+        {
+            messageLog(
+                LOG_ERR,
+                std::format("{}: {}, ran the command instead", label, started.logindError));
+        }
+
+        if (started.pid != -1)
+        {
+            m_children.push_back(Child{ started.pid, std::format("{} \"{}\"", label, action.command()) });
+        }
+    }
+    catch (const std::exception& e)
+    {
+        messageLog(LOG_ERR, std::format("{}: {}", label, e.what()));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::updateLidState(
+    LidState state,
+    std::uint64_t timestampNs,
+    std::uint64_t lineSeqno)
+{
+    const auto& transition = lidTransition(m_lidState, state);
+    const auto actions = transition.actions;
+
+    if (actions == LidAction::NONE)
+    {
+        return;
+    }
+
+    m_lidState = transition.next;
+
+    m_history.recordTransition(
+        m_lidState,
+        actions,
+        (timestampNs != 0) ? timestampNs : static_cast<std::uint64_t>(monotonicNow().count()));
+
+    if (hasAction(actions, LidAction::COUNT_OPENED))
+    {
+        ++m_metrics.lidOpened;
+    }
+
+    if (hasAction(actions, LidAction::COUNT_CLOSED))
+    {
+        ++m_metrics.lidClosed;
+    }
+
+    scheduleMetrics();
+
+    if (hasAction(actions, LidAction::LOG_STATE))
+    {
+        m_logger.logEvent(
+            LOG_INFO,
+            LogEvent::LID_STATE,
+            LogFields{
+                .lidState = toString(m_lidState),
+                .eventTimestampNs = timestampNs,
+                .lineSeqno = lineSeqno });
+    }
+
+    if (hasAction(actions, LidAction::ARM_COUNTDOWN))
+    {
+        armShutdownTimer();
+
+        if (timestampNs != 0 and m_countdownActive)
+        {
+            m_metrics.armLatency.record(monotonicNow() - std::chrono::nanoseconds(timestampNs));
+        }
+    }
+
+    if (hasAction(actions, LidAction::CANCEL_COUNTDOWN))
+    {
+        disarmShutdownTimer();
+    }
+
+    // After the countdown, so that saving power doesn't delay arming it.
+    // The countdown actions follow the lid, so power saving does too.
+
+    if (hasAction(actions, LidAction::ARM_COUNTDOWN))
+    {
+        savePower();
+    }
+
+    if (hasAction(actions, LidAction::CANCEL_COUNTDOWN))
+    {
+        restorePower();
+    }
+
+    notifyStatus();
+}
+
+//-------------------------------------------------------------------------
+
+bool
+ArgonOneUpLidMonitor::updateShutdownAction()
+{
+    // The command line overrides the configuration file. The action is
+    // replaced in place, so the countdown pipeline still points at it.
+
+    if (m_shutdownCommandSet)
+    {
+        return false;
+    }
+
+    const auto& command = m_configuration->shutdownCommand;
+    auto action = command.empty() ? ShutdownAction{} : ShutdownAction{command};
+
+    if (action.command() == m_shutdownAction.command())
+    {
+        return false;
+    }
+
+    m_shutdownAction = std::move(action);
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::watchdog()
+{
+    sd_notify(0, "WATCHDOG=1");
+    m_timers.arm(m_watchdogTimer, m_watchdogInterval);
+}
+
+//-------------------------------------------------------------------------
+
+void
+ArgonOneUpLidMonitor::writeMetrics()
+{
+    refreshMetrics();
+
+    if (m_metricsExporter.write(m_metrics))
+    {
+        m_metricsFailed = false;
+    }
+    else if (not m_metricsFailed)
+    {
+        m_metricsFailed = true;
+        perrorLog(
+            std::format(
+                "cannot write metrics file \"{}\"",
+                m_metricsExporter.path().c_str()));
+    }
 }
@@ -29,17 +29,40 @@
 
 //-------------------------------------------------------------------------
 
+#include <signal.h>
+
 #include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
 #include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
-#include <thread>
+#include <vector>
 
 #include <bsd/libutil.h>
 
 #include <gpiod.hpp>
 
+#include "configuration.h"
+#include "controlSocket.h"
+#include "countdownRecord.h"
+#include "debouncer.h"
+#include "eventHistory.h"
+#include "eventSource.h"
+#include "fileDescriptor.h"
+#include "gpioDiscovery.h"
+#include "lidStateMachine.h"
+#include "metrics.h"
+#include "monitoredLine.h"
+#include "powerSaver.h"
+#include "realtime.h"
+#include "shutdownAction.h"
+#include "logger.h"
+#include "timerScheduler.h"
+
 //-------------------------------------------------------------------------
 
 using pidFile_ptr = std::unique_ptr<pidfh, decltype(&pidfile_remove)>;
@@ -50,40 +73,168 @@ class ArgonOneUpLidMonitor
 {
 public:
 
-    enum class LidState
-    {
-        UNKNOWN,
-        OPEN,
-        CLOSED
-    };
+    using LidState = ::LidState;
 
     explicit ArgonOneUpLidMonitor(std::atomic<bool>* run);
 
+    static sigset_t handledSignals();
+
     void lidMonitor();
+    void logUsage();
+
+    // For the benchmarks: request the lines from the --replay trace and
+    // create the countdown timers, as lidMonitor() does before it starts
+    // the event loop. Each call to handleLineEvents() is then one wakeup.
+
+    void prepareReplay();
+    void handleLineEvents();
+
     void messageLog(int priority, std::string_view message) const;
     std::optional<int> parseCommandLine(int argc, char* argv[]);
     void perrorLog(std::string_view s) const;
     [[nodiscard]] const std::string& programName() const noexcept { return m_programName; }
-    std::string toString(LidState state);
-
-private:
-
-    static LidState eventTypeToLidState(gpiod::edge_event::event_type eventType);
+    static constexpr std::string_view toString(LidState state) noexcept { return lidStateName(state); }
     static LidState valueTypeToLidState(gpiod::line::value valueType);
 
-    void createShutdownThread();
-    void destroyShutdownThread();
+private:
 
-    std::string getHostname();
-    std::chrono::seconds getShutdownTimeout();
-    void printUsage(std::ostream& stream) const;
-    void shutdownTimer(std::stop_token stopToken);
+    void armNextTier();
+    std::string_view controlRequest(std::string_view request);
+    void countdownArmed();
+    void createCountdownTimers();
+    void openCountdownRecord();
+    void saveCountdown();
+    void enableRealtime();
+    void armShutdownTimer();
+    void buildPipeline();
+    void disarmShutdownTimer();
+    void recomputeCountdown();
+    void restorePower();
+    void savePower();
+    void stopCountdown();
+
+    GpioLine findLidLine(const std::string& line);
+    MonitoredLine* findLine(gpiod::line::offset offset);
+    void handleInput(const InputAction& input, gpiod::line::value value);
+    void handleSignal();
+    std::filesystem::path lidChip() const;
+    bool lidLineMoved() const;
+    std::string lidLineName() const;
+    void loadConfiguration();
+    void logHistory() const;
+    void logLatency() const;
+    void notifyStatus();
+    void printUsage(std::FILE* stream) const;
+    void refreshMetrics();
+    bool parseTier(std::string_view tier);
+    std::uint64_t pipelineHash() const;
+    void reload();
+    void requestLines();
+    void scheduleMetrics();
+    Configuration readConfiguration();
+    void reapChildren();
+    void resyncLines();
+    void runNextTier();
+    void startAction(const ShutdownAction& action, std::string_view label);
+    void watchdog();
+    void writeMetrics();
+    void updateLidState(LidState state, std::uint64_t timestampNs = 0, std::uint64_t lineSeqno = 0);
+    bool updateShutdownAction();
+
+    // Constructed first so that the other members can log.
+    mutable Logger m_logger{};
+
+    // Commands that have been started and not yet reaped, so that their
+    // exit can be logged with what they were started for.
+
+    struct Child
+    {
+        pid_t pid{-1};
+        std::string label{};
+    };
 
-    std::string m_hostname{};
+    std::vector<Child> m_children{};
+    std::shared_ptr<const Configuration> m_configuration{};
+    std::filesystem::path m_controlSocketPath{};
+    std::chrono::milliseconds m_debouncePeriod{20};
+    std::size_t m_eventBufferSize{16};
+    std::filesystem::path m_gpioChip{};
+    std::string m_gpioLine{};
+    std::vector<EdgeEvent> m_events{};
+    EventHistory m_history{};
+    std::filesystem::path m_historyPath{};
+    std::vector<InputAction> m_inputs{};
+
+    // The lid line as requested, to tell whether the configuration file,
+    // read after the request, names another one.
+
+    GpioLine m_lidGpio{};
+    LidState m_lidState{LidState::UNKNOWN};
+
+    // The lid switch is always the first line.
+
+    std::vector<MonitoredLine> m_lines{};
+    std::unique_ptr<EventSource> m_eventSource{};
+    std::uint64_t m_lastGlobalSeqno{0};
+    Metrics m_metrics{};
+    MetricsExporter m_metricsExporter{std::filesystem::path{}};
+    bool m_metricsFailed{false};
+    unsigned m_powerSaveSettings{0};
+    PowerSaver m_powerSaver{};
     std::string m_programName{};
+    RealtimeSettings m_realtime{};
+    std::filesystem::path m_replayPath{};
     std::atomic<bool>* m_run{nullptr};
-    std::string m_shutdownCommand{};
-    std::jthread m_shutdownThread{};
+    ShutdownAction m_shutdownAction{};
+    bool m_shutdownCommandSet{false};
+    std::chrono::nanoseconds m_shutdownDeadline{0};
+    FileDescriptor m_signalFd{};
+    bool m_startupTrace{false};
+    TimerScheduler m_timers{};
+    TimerScheduler::TimerId m_shutdownTimer{};
+    TimerScheduler::TimerId m_debounceTimer{};
+    TimerScheduler::TimerId m_metricsTimer{};
+    TimerScheduler::TimerId m_watchdogTimer{};
+    std::chrono::microseconds m_watchdogInterval{0};
+
+    // The tiers from the command line, sorted by delay, and the steps of
+    // the current lid closed countdown: those tiers plus the shutdown.
+
+    struct PipelineStep
+    {
+        std::chrono::seconds delay{0};
+        const ShutdownAction* action{nullptr};
+    };
+
+    std::vector<ActionTier> m_tiers{};
+    std::vector<PipelineStep> m_pipeline{};
+    std::size_t m_nextTier{0};
+    bool m_countdownActive{false};
+
+    // Set while the lid is closed without a countdown, because there were
+    // no countdown steps, so that a reload adding some can arm it.
+
+    bool m_countdownWaiting{false};
+    std::chrono::nanoseconds m_closedAt{0};
+
+    // The countdown runs on its own timer so that it can use a clock that
+    // keeps counting, and wakes the system, while it is suspended.
+
+    bool m_wakeAlarm{false};
+    std::optional<TimerScheduler> m_countdownTimers{};
+
+    // The countdown is saved so that a restarted service carries on with
+    // it. m_resumeCountdown is the saved countdown found at startup.
+
+    std::optional<CountdownRecord> m_countdownRecord{};
+    std::optional<CountdownRecord::State> m_resumeCountdown{};
+
+    // Formatted whenever the state changes, so that state queries on the
+    // control socket are answered without formatting anything.
+
+    std::string m_snapshot{};
+    std::size_t m_deadlineOffset{0};
+    std::string m_reply{};
 };
 
 //-------------------------------------------------------------------------
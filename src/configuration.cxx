@@ -0,0 +1,249 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <charconv>
+#include <cstdint>
+
+#include "configuration.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+constexpr bool
+isSpace(
+    char c) noexcept
+{
+    return c == ' ' or c == '\t' or c == '\r' or c == '\v' or c == '\f';
+}
+
+//-------------------------------------------------------------------------
+
+constexpr std::string_view
+trim(
+    std::string_view str) noexcept
+{
+    while (not str.empty() and isSpace(str.front()))
+    {
+        str.remove_prefix(1);
+    }
+
+    while (not str.empty() and isSpace(str.back()))
+    {
+        str.remove_suffix(1);
+    }
+
+    return str;
+}
+
+//-------------------------------------------------------------------------
+
+template<typename T>
+bool
+parseNumber(
+    std::string_view str,
+    T& value) noexcept
+{
+    const auto last = str.data() + str.size();
+    const auto [ptr, ec] = std::from_chars(str.data(), last, value);
+
+    return ec == std::errc{} and ptr == last;
+}
+
+//-------------------------------------------------------------------------
+
+// A # at the start of a value, or after white space, starts a comment
+// that runs to the end of the line. A # inside a word, as in a command
+// argument, does not.
+
+constexpr std::string_view
+stripComment(
+    std::string_view value) noexcept
+{
+    for (std::size_t i = 0 ; i < value.size() ; ++i)
+    {
+        if (value[i] == '#' and (i == 0 or isSpace(value[i - 1])))
+        {
+            return trim(value.substr(0, i));
+        }
+    }
+
+    return value;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+parseLidShutdownSecs(
+    std::string_view value,
+    Configuration& configuration) noexcept
+{
+    std::uint32_t seconds{0};
+
+    if (not parseNumber(value, seconds))
+    {
+        return false;
+    }
+
+    configuration.lidShutdownTimeout = std::chrono::seconds(seconds);
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+parseGpioChip(
+    std::string_view value,
+    Configuration& configuration)
+{
+    if (value.empty())
+    {
+        return false;
+    }
+
+    configuration.gpioChip = value;
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+parseGpioLine(
+    std::string_view value,
+    Configuration& configuration)
+{
+    if (value.empty())
+    {
+        return false;
+    }
+
+    configuration.gpioLine = value;
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+parseShutdownCommand(
+    std::string_view value,
+    Configuration& configuration)
+{
+    if (value.empty())
+    {
+        return false;
+    }
+
+    configuration.shutdownCommand = value;
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+struct Key
+{
+    std::string_view name;
+    bool (*parse)(std::string_view value, Configuration& configuration);
+};
+
+constexpr std::array c_keys
+{
+    Key{ "lidshutdownsecs", parseLidShutdownSecs },
+    Key{ "lidgpiochip", parseGpioChip },
+    Key{ "lidgpioline", parseGpioLine },
+    Key{ "lidshutdowncommand", parseShutdownCommand }
+};
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+ConfigurationParseResult
+parseConfiguration(
+    std::string_view text,
+    Configuration& configuration)
+{
+    ConfigurationParseResult result;
+    std::bitset<c_keys.size()> seen;
+    std::size_t lineNumber{0};
+
+    while (not text.empty())
+    {
+        const auto newline = text.find('\n');
+        auto line = text.substr(0, newline);
+        text.remove_prefix((newline == std::string_view::npos) ? text.size() : newline + 1);
+        ++lineNumber;
+
+        line = trim(line);
+
+        if (line.empty() or line.starts_with('#'))
+        {
+            continue;
+        }
+
+        const auto equals = line.find('=');
+        if (equals == std::string_view::npos)
+        {
+            continue;
+        }
+
+        const auto name = trim(line.substr(0, equals));
+        const auto value = stripComment(trim(line.substr(equals + 1)));
+
+        const auto key = std::ranges::find(c_keys, name, &Key::name);
+        if (key == end(c_keys))
+        {
+            continue;
+        }
+
+        const auto index = static_cast<std::size_t>(key - begin(c_keys));
+        if (seen.test(index))
+        {
+            continue;
+        }
+
+        if (key->parse(value, configuration))
+        {
+            seen.set(index);
+            ++result.keys;
+        }
+        else if (result.invalidLine == 0)
+        {
+            result.invalidLine = lineNumber;
+        }
+    }
+
+    return result;
+}
+
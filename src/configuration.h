@@ -0,0 +1,76 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+//-------------------------------------------------------------------------
+
+// An immutable snapshot of the settings read from the configuration file.
+// A new snapshot is built whenever the file changes.
+
+struct Configuration
+{
+    std::chrono::seconds lidShutdownTimeout{0};
+    std::string gpioChip{};
+    std::string gpioLine{};
+    std::string shutdownCommand{};
+};
+
+//-------------------------------------------------------------------------
+
+struct ConfigurationParseResult
+{
+    std::size_t keys{0};
+    std::size_t invalidLine{0};
+};
+
+//-------------------------------------------------------------------------
+
+// Parse the text of an Argon40 configuration file in a single pass. Only
+// the keys in Configuration are parsed. The other Argon40 settings, such
+// as those for the fan, are left to the Argon40 code and are skipped, as
+// are blank lines and comments. A comment can also follow any value,
+// starting with a # at the start of the value or after white space. Only
+// the string settings can allocate, and short strings such as a gpio chip
+// path fit in the small string buffer. The first occurrence of a key
+// wins. If a value cannot be parsed the line number is returned in
+// invalidLine and that key is left at its default.
+
+ConfigurationParseResult
+parseConfiguration(
+    std::string_view text,
+    Configuration& configuration);
+
+//-------------------------------------------------------------------------
+
@@ -0,0 +1,226 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <systemd/sd-daemon.h>
+
+#include <algorithm>
+#include <cstring>
+#include <system_error>
+#include <utility>
+
+#include "controlSocket.h"
+
+//=========================================================================
+
+ControlSocket::ControlSocket(
+    EventLoop& eventLoop,
+    const std::filesystem::path& path,
+    Handler handler)
+:
+    m_eventLoop{eventLoop},
+    m_handler{std::move(handler)},
+    m_path{},
+    m_activated{false},
+    m_listenFd{},
+    m_clients{},
+    m_request{}
+{
+    if (sd_listen_fds(0) == 1 and
+        sd_is_socket_unix(SD_LISTEN_FDS_START, SOCK_SEQPACKET, 1, nullptr, 0) > 0)
+    {
+        m_listenFd = FileDescriptor{SD_LISTEN_FDS_START};
+        m_activated = true;
+    }
+    else if (not path.empty())
+    {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+
+        if (path.native().size() >= sizeof(address.sun_path))
+        {
+            throw std::system_error(ENAMETOOLONG, std::generic_category(), path.string());
+        }
+
+        std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+        FileDescriptor fd{::socket(AF_UNIX, SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC, 0)};
+        if (not fd.valid())
+        {
+            throw std::system_error(errno, std::generic_category(), "socket");
+        }
+
+        // Only root can connect, as the commands affect the shutdown.
+
+        ::unlink(path.c_str());
+        const auto mask = ::umask(0077);
+        const int bound = ::bind(fd.get(), reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+        ::umask(mask);
+
+        if (bound == -1)
+        {
+            throw std::system_error(errno, std::generic_category(), "bind");
+        }
+
+        // The destructor doesn't run if the constructor throws, so remove
+        // the socket path on the way out from here on.
+
+        m_path = path;
+
+        if (::listen(fd.get(), static_cast<int>(c_maxClients)) == -1)
+        {
+            const int error = errno;
+            ::unlink(m_path.c_str());
+            throw std::system_error(error, std::generic_category(), "listen");
+        }
+
+        m_listenFd = std::move(fd);
+    }
+    else
+    {
+        return;
+    }
+
+    try
+    {
+        m_clients.reserve(c_maxClients);
+
+        m_eventLoop.add(
+            m_listenFd.get(),
+            EPOLLIN,
+            [this](std::uint32_t) { accept(); });
+    }
+    catch (...)
+    {
+        if (not m_path.empty())
+        {
+            ::unlink(m_path.c_str());
+        }
+
+        throw;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+ControlSocket::~ControlSocket()
+{
+    for (const auto& client : m_clients)
+    {
+        m_eventLoop.remove(client.get());
+    }
+
+    if (m_listenFd.valid())
+    {
+        m_eventLoop.remove(m_listenFd.get());
+    }
+
+    // A socket passed by systemd belongs to systemd.
+
+    if (not m_path.empty())
+    {
+        ::unlink(m_path.c_str());
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ControlSocket::accept()
+{
+    FileDescriptor fd{::accept4(m_listenFd.get(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC)};
+    if (not fd.valid())
+    {
+        return;
+    }
+
+    // Further clients are turned away rather than allowed to use up fds.
+
+    if (m_clients.size() == c_maxClients)
+    {
+        return;
+    }
+
+    const int client = fd.get();
+    m_clients.push_back(std::move(fd));
+
+    m_eventLoop.add(
+        client,
+        EPOLLIN | EPOLLRDHUP,
+        [this, client](std::uint32_t events) { serve(client, events); });
+}
+
+//-------------------------------------------------------------------------
+
+void
+ControlSocket::disconnect(
+    int fd)
+{
+    m_eventLoop.remove(fd);
+    std::erase_if(m_clients, [fd](const auto& client) { return client.get() == fd; });
+}
+
+//-------------------------------------------------------------------------
+
+void
+ControlSocket::serve(
+    int fd,
+    std::uint32_t events)
+{
+    if (events & EPOLLIN)
+    {
+        const auto length = ::recv(fd, m_request.data(), m_request.size(), 0);
+
+        if (length > 0)
+        {
+            std::string_view request(m_request.data(), static_cast<std::size_t>(length));
+
+            while (request.ends_with('\n') or request.ends_with('\r'))
+            {
+                request.remove_suffix(1);
+            }
+
+            const auto reply = m_handler(request);
+            ::send(fd, reply.data(), reply.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+            return;
+        }
+
+        if (length == -1 and (errno == EAGAIN or errno == EINTR))
+        {
+            return;
+        }
+    }
+
+    disconnect(fd);
+}
+
+//-------------------------------------------------------------------------
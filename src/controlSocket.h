@@ -0,0 +1,82 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+#include "eventLoop.h"
+#include "fileDescriptor.h"
+
+//-------------------------------------------------------------------------
+
+// A SOCK_SEQPACKET unix socket served by the event loop. Each packet a
+// client sends is one request and gets one packet in reply, from the
+// handler. The socket is taken from systemd if the service was socket
+// activated, otherwise it is bound to the given path, if there is one.
+
+class ControlSocket
+{
+public:
+
+    using Handler = std::function<std::string_view(std::string_view request)>;
+
+    static constexpr std::size_t c_maxClients{8};
+    static constexpr std::size_t c_maxRequestLength{256};
+
+    ControlSocket(EventLoop& eventLoop, const std::filesystem::path& path, Handler handler);
+    ~ControlSocket();
+
+    ControlSocket(const ControlSocket&) = delete;
+    ControlSocket& operator=(const ControlSocket&) = delete;
+
+    [[nodiscard]] bool enabled() const noexcept { return m_listenFd.valid(); }
+    [[nodiscard]] bool activated() const noexcept { return m_activated; }
+
+private:
+
+    void accept();
+    void disconnect(int fd);
+    void serve(int fd, std::uint32_t events);
+
+    EventLoop& m_eventLoop;
+    Handler m_handler{};
+    std::filesystem::path m_path{};
+    bool m_activated{false};
+    FileDescriptor m_listenFd{};
+    std::vector<FileDescriptor> m_clients{};
+    std::array<char, c_maxRequestLength> m_request{};
+};
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,159 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <system_error>
+
+#include "countdownRecord.h"
+#include "fileDescriptor.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+constexpr std::uint32_t c_magic{0x41524743}; // "ARGC"
+constexpr std::uint32_t c_version{2};
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+CountdownRecord::CountdownRecord()
+:
+    m_record{nullptr}
+{
+    const FileDescriptor fd{::open(c_path.data(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)};
+    if (not fd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), "open");
+    }
+
+    if (::ftruncate(fd.get(), sizeof(Record)) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "ftruncate");
+    }
+
+    void* data = ::mmap(nullptr, sizeof(Record), PROT_READ | PROT_WRITE, MAP_SHARED, fd.get(), 0);
+    if (data == MAP_FAILED)
+    {
+        throw std::system_error(errno, std::generic_category(), "mmap");
+    }
+
+    m_record = static_cast<Record*>(data);
+}
+
+//-------------------------------------------------------------------------
+
+CountdownRecord::~CountdownRecord()
+{
+    if (m_record != nullptr)
+    {
+        ::munmap(m_record, sizeof(Record));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::uint64_t
+CountdownRecord::checksum(
+    const Record& record) noexcept
+{
+    // FNV-1a over everything but the checksum, enough to catch a record
+    // that was being written when the service died.
+
+    std::uint64_t hash{0xcbf29ce484222325};
+    const auto bytes = reinterpret_cast<const unsigned char*>(&record);
+
+    for (std::size_t i = 0 ; i < offsetof(Record, checksum) ; ++i)
+    {
+        hash = (hash ^ bytes[i]) * 0x100000001b3;
+    }
+
+    return hash;
+}
+
+//-------------------------------------------------------------------------
+
+void
+CountdownRecord::clear() noexcept
+{
+    m_record->active = 0;
+    m_record->checksum = checksum(*m_record);
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<CountdownRecord::State>
+CountdownRecord::load() const noexcept
+{
+    Record record;
+    std::memcpy(&record, m_record, sizeof(record));
+
+    if (record.magic != c_magic or
+        record.version != c_version or
+        record.checksum != checksum(record) or
+        record.active == 0)
+    {
+        return std::nullopt;
+    }
+
+    return State{
+        static_cast<clockid_t>(record.clock),
+        std::chrono::nanoseconds(record.closedAtNs),
+        static_cast<std::size_t>(record.nextTier),
+        record.pipelineHash };
+}
+
+//-------------------------------------------------------------------------
+
+void
+CountdownRecord::save(
+    const State& state) noexcept
+{
+    Record record{};
+    record.magic = c_magic;
+    record.version = c_version;
+    record.clock = static_cast<std::int32_t>(state.clock);
+    record.active = 1;
+    record.closedAtNs = state.closedAt.count();
+    record.nextTier = state.nextTier;
+    record.pipelineHash = state.pipelineHash;
+    record.checksum = checksum(record);
+
+    std::memcpy(m_record, &record, sizeof(record));
+}
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,97 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <time.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+//-------------------------------------------------------------------------
+
+// The state of the lid closed countdown, kept in a small memory mapped
+// file in /run so that it survives the service being restarted. The
+// record is written in place whenever the countdown changes, which costs
+// no system calls, and the page outlives the process. On startup a valid
+// record lets the countdown carry on from where it was, rather than start
+// again. /run is cleared on boot, so a record is never from an earlier
+// boot, but it is still checked for the clock it was timed with. The
+// record also keeps a hash of the countdown steps, so that a restart with
+// different steps doesn't carry on from a step that means something else.
+
+class CountdownRecord
+{
+public:
+
+    static constexpr std::string_view c_path{"/run/argonOneUpLidMonitor.countdown"};
+
+    struct State
+    {
+        clockid_t clock{CLOCK_MONOTONIC};
+        std::chrono::nanoseconds closedAt{0};
+        std::size_t nextTier{0};
+        std::uint64_t pipelineHash{0};
+    };
+
+    // Throws std::system_error if the file cannot be opened or mapped.
+
+    CountdownRecord();
+    ~CountdownRecord();
+
+    CountdownRecord(const CountdownRecord&) = delete;
+    CountdownRecord& operator=(const CountdownRecord&) = delete;
+
+    [[nodiscard]] std::optional<State> load() const noexcept;
+    void save(const State& state) noexcept;
+    void clear() noexcept;
+
+private:
+
+    struct Record
+    {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::int32_t clock;
+        std::uint32_t active;
+        std::int64_t closedAtNs;
+        std::uint64_t nextTier;
+        std::uint64_t pipelineHash;
+        std::uint64_t checksum;
+    };
+
+    static std::uint64_t checksum(const Record& record) noexcept;
+
+    Record* m_record{nullptr};
+};
+
+//-------------------------------------------------------------------------
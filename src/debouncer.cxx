@@ -0,0 +1,63 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include "debouncer.h"
+
+//=========================================================================
+
+Debouncer::Debouncer(
+    std::chrono::nanoseconds period)
+:
+    m_period{period},
+    m_lastAccepted{},
+    m_suppressed{0}
+{
+}
+
+//-------------------------------------------------------------------------
+
+bool
+Debouncer::accept(
+    std::uint64_t timestampNs)
+{
+    if (not enabled())
+    {
+        return true;
+    }
+
+    const auto period = static_cast<std::uint64_t>(m_period.count());
+
+    if (m_lastAccepted.has_value() and (timestampNs - *m_lastAccepted) < period)
+    {
+        ++m_suppressed;
+        return false;
+    }
+
+    m_lastAccepted = timestampNs;
+    return true;
+}
+
@@ -0,0 +1,64 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+#include <optional>
+
+//-------------------------------------------------------------------------
+
+// Software debounce using the kernel timestamps of the edge events. The
+// first edge is accepted straight away and any further edges within the
+// debounce period of it are suppressed. The caller is expected to re-read
+// the line once the period has passed if anything was suppressed.
+
+class Debouncer
+{
+public:
+
+    explicit Debouncer(std::chrono::nanoseconds period = std::chrono::nanoseconds{0});
+
+    bool accept(std::uint64_t timestampNs);
+    void reset() noexcept { m_lastAccepted.reset(); }
+
+    [[nodiscard]] bool enabled() const noexcept { return m_period.count() > 0; }
+    [[nodiscard]] std::chrono::nanoseconds period() const noexcept { return m_period; }
+    [[nodiscard]] std::uint64_t suppressed() const noexcept { return m_suppressed; }
+
+private:
+
+    std::chrono::nanoseconds m_period{0};
+    std::optional<std::uint64_t> m_lastAccepted{};
+    std::uint64_t m_suppressed{0};
+};
+
+//-------------------------------------------------------------------------
+
@@ -0,0 +1,237 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <array>
+#include <format>
+#include <string_view>
+#include <utility>
+
+#include "eventHistory.h"
+#include "fileDescriptor.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+std::string_view
+verdictName(
+    EventHistory::Verdict verdict)
+{
+    switch (verdict)
+    {
+        case EventHistory::Verdict::ACCEPTED:
+            return "accepted";
+        case EventHistory::Verdict::SUPPRESSED:
+            return "suppressed by debounce";
+        default:
+            return "not monitored";
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+actionNames(
+    LidAction actions)
+{
+    constexpr std::array c_actions
+    {
+        std::pair{ LidAction::ARM_COUNTDOWN, std::string_view{" arm countdown"} },
+        std::pair{ LidAction::CANCEL_COUNTDOWN, std::string_view{" cancel countdown"} }
+    };
+
+    std::string names;
+
+    for (const auto& [action, name] : c_actions)
+    {
+        if (hasAction(actions, action))
+        {
+            names += name;
+        }
+    }
+
+    return names;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+EventHistory::Entry&
+EventHistory::next() noexcept
+{
+    auto& entry = m_entries[m_recorded % c_capacity];
+    ++m_recorded;
+
+    entry = Entry{};
+    return entry;
+}
+
+//-------------------------------------------------------------------------
+
+void
+EventHistory::recordEdge(
+    const EdgeEvent& event,
+    Verdict verdict) noexcept
+{
+    auto& entry = next();
+    entry.timestampNs = event.timestampNs;
+    entry.globalSeqno = event.globalSeqno;
+    entry.lineSeqno = event.lineSeqno;
+    entry.offset = event.offset;
+    entry.kind = Kind::EDGE;
+    entry.edge = event.type;
+    entry.verdict = verdict;
+}
+
+//-------------------------------------------------------------------------
+
+void
+EventHistory::recordTransition(
+    LidState state,
+    LidAction actions,
+    std::uint64_t timestampNs) noexcept
+{
+    auto& entry = next();
+    entry.timestampNs = timestampNs;
+    entry.kind = Kind::TRANSITION;
+    entry.state = state;
+    entry.actions = actions;
+}
+
+//-------------------------------------------------------------------------
+
+void
+EventHistory::recordAction(
+    std::size_t tier,
+    std::uint64_t timestampNs) noexcept
+{
+    auto& entry = next();
+    entry.timestampNs = timestampNs;
+    entry.kind = Kind::ACTION;
+    entry.tier = static_cast<std::uint32_t>(tier);
+}
+
+//-------------------------------------------------------------------------
+
+std::size_t
+EventHistory::size() const noexcept
+{
+    return (m_recorded < c_capacity) ? static_cast<std::size_t>(m_recorded) : c_capacity;
+}
+
+//-------------------------------------------------------------------------
+
+const EventHistory::Entry&
+EventHistory::at(
+    std::size_t i) const noexcept
+{
+    const auto first = m_recorded - size();
+
+    return m_entries[(first + i) % c_capacity];
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+EventHistory::describe(
+    const Entry& entry)
+{
+    const auto seconds = static_cast<double>(entry.timestampNs) / 1e9;
+
+    switch (entry.kind)
+    {
+        case Kind::EDGE:
+
+            return std::format(
+                "{:.6f} edge line {} {} seqno {}/{} {}",
+                seconds,
+                entry.offset,
+                (entry.edge == gpiod::edge_event::event_type::RISING_EDGE) ? "rising" : "falling",
+                entry.globalSeqno,
+                entry.lineSeqno,
+                verdictName(entry.verdict));
+
+        case Kind::TRANSITION:
+
+            return std::format(
+                "{:.6f} lid {}{}",
+                seconds,
+                lidStateName(entry.state),
+                actionNames(entry.actions));
+
+        default:
+
+            return std::format("{:.6f} countdown step {} due", seconds, entry.tier);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+EventHistory::write(
+    const std::filesystem::path& path) const
+{
+    const FileDescriptor fd{::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644)};
+    if (not fd.valid())
+    {
+        return false;
+    }
+
+    std::string text;
+
+    for (std::size_t i = 0 ; i < size() ; ++i)
+    {
+        text += describe(at(i));
+        text += '\n';
+    }
+
+    std::string_view remaining{text};
+
+    while (not remaining.empty())
+    {
+        const auto length = ::write(fd.get(), remaining.data(), remaining.size());
+        if (length == -1)
+        {
+            return false;
+        }
+
+        remaining.remove_prefix(static_cast<std::size_t>(length));
+    }
+
+    return ::fsync(fd.get()) == 0;
+}
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,114 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+#include <gpiod.hpp>
+
+#include "eventSource.h"
+#include "lidStateMachine.h"
+
+//-------------------------------------------------------------------------
+
+// The last c_capacity edges, lid state transitions and countdown actions,
+// kept so that they can be looked at after something unexpected happens,
+// even if the journal was never flushed. Entries are a cache line each
+// and are written in place, so recording never allocates. There is one
+// writer, the event loop, which is also the only reader, so no locking is
+// needed.
+
+class EventHistory
+{
+public:
+
+    static constexpr std::size_t c_capacity{128};
+
+    enum class Kind : std::uint8_t
+    {
+        EDGE,
+        TRANSITION,
+        ACTION
+    };
+
+    enum class Verdict : std::uint8_t
+    {
+        ACCEPTED,
+        SUPPRESSED,
+        IGNORED
+    };
+
+    struct alignas(64) Entry
+    {
+        // The kernel timestamp for edges, CLOCK_MONOTONIC otherwise.
+
+        std::uint64_t timestampNs{0};
+        std::uint64_t globalSeqno{0};
+        std::uint64_t lineSeqno{0};
+        gpiod::line::offset offset{0};
+        std::uint32_t tier{0};
+        Kind kind{Kind::EDGE};
+        gpiod::edge_event::event_type edge{gpiod::edge_event::event_type::RISING_EDGE};
+        Verdict verdict{Verdict::ACCEPTED};
+        LidState state{LidState::UNKNOWN};
+        LidAction actions{LidAction::NONE};
+    };
+
+    static_assert(sizeof(Entry) == 64);
+
+    void recordEdge(const EdgeEvent& event, Verdict verdict) noexcept;
+    void recordTransition(LidState state, LidAction actions, std::uint64_t timestampNs) noexcept;
+    void recordAction(std::size_t tier, std::uint64_t timestampNs) noexcept;
+
+    [[nodiscard]] std::size_t size() const noexcept;
+
+    // Entry i, oldest first.
+
+    [[nodiscard]] const Entry& at(std::size_t i) const noexcept;
+
+    static std::string describe(const Entry& entry);
+
+    // Writes every entry, one per line, and syncs the file.
+
+    bool write(const std::filesystem::path& path) const;
+
+private:
+
+    Entry& next() noexcept;
+
+    std::array<Entry, c_capacity> m_entries{};
+    std::uint64_t m_recorded{0};
+};
+
+//-------------------------------------------------------------------------
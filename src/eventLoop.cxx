@@ -0,0 +1,137 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <errno.h>
+#include <sys/epoll.h>
+
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <system_error>
+
+#include "eventLoop.h"
+
+//=========================================================================
+
+EventLoop::EventLoop()
+:
+    m_epollFd{::epoll_create1(EPOLL_CLOEXEC)},
+    m_registrations{},
+    m_dispatching{false}
+{
+    if (not m_epollFd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), "epoll_create1");
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+EventLoop::add(
+    int fd,
+    std::uint32_t events,
+    Handler handler)
+{
+    auto registration = std::make_unique<Registration>(fd, std::move(handler), false);
+
+    epoll_event event{};
+    event.events = events;
+    event.data.ptr = registration.get();
+
+    if (::epoll_ctl(m_epollFd.get(), EPOLL_CTL_ADD, fd, &event) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "epoll_ctl add");
+    }
+
+    m_registrations.push_back(std::move(registration));
+}
+
+//-------------------------------------------------------------------------
+
+void
+EventLoop::remove(
+    int fd)
+{
+    ::epoll_ctl(m_epollFd.get(), EPOLL_CTL_DEL, fd, nullptr);
+
+    for (auto& registration : m_registrations)
+    {
+        if (registration->fd == fd)
+        {
+            registration->removed = true;
+        }
+    }
+
+    if (not m_dispatching)
+    {
+        std::erase_if(m_registrations, [](const auto& registration) { return registration->removed; });
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+EventLoop::wait(
+    int timeoutMilliseconds)
+{
+    constexpr int maxEvents{8};
+    std::array<epoll_event, maxEvents> events;
+
+    const int count = ::epoll_wait(
+        m_epollFd.get(),
+        events.data(),
+        maxEvents,
+        timeoutMilliseconds);
+
+    if (count == -1)
+    {
+        if (errno == EINTR)
+        {
+            return;
+        }
+
+        throw std::system_error(errno, std::generic_category(), "epoll_wait");
+    }
+
+    m_dispatching = true;
+
+    for (const auto& event : events | std::views::take(count))
+    {
+        auto registration = static_cast<Registration*>(event.data.ptr);
+
+        if (not registration->removed)
+        {
+            registration->handler(event.events);
+        }
+    }
+
+    m_dispatching = false;
+
+    std::erase_if(m_registrations, [](const auto& registration) { return registration->removed; });
+}
+
@@ -0,0 +1,72 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "fileDescriptor.h"
+
+//-------------------------------------------------------------------------
+
+class EventLoop
+{
+public:
+
+    using Handler = std::function<void(std::uint32_t events)>;
+
+    EventLoop();
+
+    void add(int fd, std::uint32_t events, Handler handler);
+    void remove(int fd);
+    void wait(int timeoutMilliseconds = -1);
+
+private:
+
+    struct Registration
+    {
+        int fd{-1};
+        Handler handler{};
+        bool removed{false};
+    };
+
+    // A handler may remove its own, or another, fd. The registration is
+    // only freed once the events from epoll_wait have been dispatched, as
+    // they may still point at it.
+
+    FileDescriptor m_epollFd{};
+    std::vector<std::unique_ptr<Registration>> m_registrations{};
+    bool m_dispatching{false};
+};
+
+//-------------------------------------------------------------------------
+
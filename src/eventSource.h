@@ -0,0 +1,83 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <gpiod.hpp>
+
+//-------------------------------------------------------------------------
+
+// An edge on one of the monitored lines, copied out of the source so that
+// the monitor doesn't depend on where the edges come from.
+
+struct EdgeEvent
+{
+    gpiod::line::offset offset{0};
+    gpiod::edge_event::event_type type{gpiod::edge_event::event_type::RISING_EDGE};
+    std::uint64_t timestampNs{0};
+    std::uint64_t globalSeqno{0};
+    std::uint64_t lineSeqno{0};
+};
+
+//-------------------------------------------------------------------------
+
+// Where the monitor gets its edges and line values from: the gpio line
+// request, or a recorded trace. fd() is polled by the event loop and is
+// readable while there are edges to read.
+
+class EventSource
+{
+public:
+
+    virtual ~EventSource() = default;
+
+    [[nodiscard]] virtual int fd() const = 0;
+
+    // Returns true if there are edges to read within the timeout.
+
+    virtual bool wait(std::chrono::nanoseconds timeout) = 0;
+
+    // Reads up to events.size() edges and returns the number read.
+
+    virtual std::size_t read(std::span<EdgeEvent> events) = 0;
+
+    virtual gpiod::line::value value(gpiod::line::offset offset) = 0;
+
+    // The number of system calls made so far, for the wakeup and system
+    // call accounting.
+
+    [[nodiscard]] virtual std::uint64_t syscalls() const noexcept = 0;
+};
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,84 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <unistd.h>
+
+#include <utility>
+
+//-------------------------------------------------------------------------
+
+class FileDescriptor
+{
+public:
+
+    FileDescriptor() = default;
+    explicit FileDescriptor(int fd) noexcept : m_fd(fd) {}
+    ~FileDescriptor() { close(); }
+
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+
+    FileDescriptor(FileDescriptor&& rhs) noexcept
+    :
+        m_fd(std::exchange(rhs.m_fd, -1))
+    {
+    }
+
+    FileDescriptor& operator=(FileDescriptor&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            close();
+            m_fd = std::exchange(rhs.m_fd, -1);
+        }
+
+        return *this;
+    }
+
+    [[nodiscard]] int get() const noexcept { return m_fd; }
+    [[nodiscard]] bool valid() const noexcept { return m_fd != -1; }
+
+    void close() noexcept
+    {
+        if (m_fd != -1)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+    }
+
+private:
+
+    int m_fd{-1};
+};
+
+//-------------------------------------------------------------------------
+
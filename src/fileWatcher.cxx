@@ -0,0 +1,86 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstdint>
+#include <system_error>
+
+#include "fileWatcher.h"
+
+//=========================================================================
+
+FileWatcher::FileWatcher(
+    const std::filesystem::path& path)
+:
+    m_filename{path.filename().string()},
+    m_inotifyFd{::inotify_init1(IN_NONBLOCK | IN_CLOEXEC)}
+{
+    if (not m_inotifyFd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), "inotify_init1");
+    }
+
+    const auto directory = path.parent_path();
+    constexpr std::uint32_t mask{IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE};
+
+    if (::inotify_add_watch(m_inotifyFd.get(), directory.c_str(), mask) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "inotify_add_watch");
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+FileWatcher::changed()
+{
+    alignas(inotify_event) std::array<char, 4096> buffer;
+    bool result{false};
+
+    ssize_t length{0};
+    while ((length = ::read(m_inotifyFd.get(), buffer.data(), buffer.size())) > 0)
+    {
+        for (ssize_t offset = 0 ; offset < length ; )
+        {
+            const auto event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+
+            if (event->len > 0 and m_filename == event->name)
+            {
+                result = true;
+            }
+
+            offset += sizeof(inotify_event) + event->len;
+        }
+    }
+
+    return result;
+}
+
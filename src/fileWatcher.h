@@ -0,0 +1,60 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <filesystem>
+#include <string>
+
+#include "fileDescriptor.h"
+
+//-------------------------------------------------------------------------
+
+// Watches a single file using inotify. The parent directory is watched so
+// that files replaced by a rename (as most editors do) are also seen.
+// Creating the file is not a change until it has been written and closed,
+// so a reload never sees it empty part way through being written.
+
+class FileWatcher
+{
+public:
+
+    explicit FileWatcher(const std::filesystem::path& path);
+
+    [[nodiscard]] bool changed();
+    [[nodiscard]] int fd() const noexcept { return m_inotifyFd.get(); }
+
+private:
+
+    std::string m_filename{};
+    FileDescriptor m_inotifyFd{};
+};
+
+//-------------------------------------------------------------------------
+
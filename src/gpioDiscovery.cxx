@@ -0,0 +1,321 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <format>
+#include <memory>
+#include <stdexcept>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "fileDescriptor.h"
+#include "gpioDiscovery.h"
+
+//=========================================================================
+
+GpioDiscovery::GpioDiscovery(
+    std::filesystem::path chip,
+    std::string line)
+:
+    m_chip{std::move(chip)},
+    m_line{std::move(line)}
+{
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<GpioLine>
+GpioDiscovery::findOnChip(
+    const std::filesystem::path& path) const
+{
+    gpiod::chip chip(path);
+
+    if (const auto offset = lineOffset(); offset.has_value())
+    {
+        if (*offset < chip.get_info().num_lines())
+        {
+            return GpioLine{ path, *offset };
+        }
+
+        return std::nullopt;
+    }
+
+    const int offset = chip.get_line_offset_from_name(m_line);
+    if (offset < 0)
+    {
+        return std::nullopt;
+    }
+
+    return GpioLine{ path, static_cast<gpiod::line::offset>(offset) };
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<gpiod::line::offset>
+GpioDiscovery::lineOffset() const
+{
+    gpiod::line::offset offset{0};
+    const auto last = m_line.data() + m_line.size();
+    const auto [ptr, ec] = std::from_chars(m_line.data(), last, offset);
+
+    if (ec != std::errc{} or ptr != last)
+    {
+        return std::nullopt;
+    }
+
+    return offset;
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<GpioLine>
+GpioDiscovery::readCache() const
+{
+    const FileDescriptor fd{::open(c_cachePath.data(), O_RDONLY | O_CLOEXEC)};
+    if (not fd.valid())
+    {
+        return std::nullopt;
+    }
+
+    std::array<char, 256> buffer;
+    const auto length = ::read(fd.get(), buffer.data(), buffer.size());
+    if (length <= 0)
+    {
+        return std::nullopt;
+    }
+
+    // The cache holds "<line> <chip path> <offset>\n".
+
+    std::string_view text(buffer.data(), static_cast<std::size_t>(length));
+
+    const auto first = text.find(' ');
+    const auto last = text.rfind(' ');
+    if (first == std::string_view::npos or first == last or not text.ends_with('\n'))
+    {
+        return std::nullopt;
+    }
+
+    if (text.substr(0, first) != m_line)
+    {
+        return std::nullopt;
+    }
+
+    GpioLine line;
+    line.chip = text.substr(first + 1, last - first - 1);
+
+    const auto offsetText = text.substr(last + 1, text.size() - last - 2);
+    const auto [ptr, ec] = std::from_chars(
+        offsetText.data(),
+        offsetText.data() + offsetText.size(),
+        line.offset);
+
+    if (ec != std::errc{})
+    {
+        return std::nullopt;
+    }
+
+    // Check that the chip still has the line at that offset.
+
+    try
+    {
+        if (not gpiod::is_gpiochip_device(line.chip))
+        {
+            return std::nullopt;
+        }
+
+        gpiod::chip chip(line.chip);
+
+        if (lineOffset().has_value())
+        {
+            if (line.offset >= chip.get_info().num_lines())
+            {
+                return std::nullopt;
+            }
+        }
+        else if (chip.get_line_info(line.offset).name() != m_line)
+        {
+            return std::nullopt;
+        }
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+
+    return line;
+}
+
+//-------------------------------------------------------------------------
+
+GpioLine
+GpioDiscovery::resolve(
+    bool& searched) const
+{
+    searched = false;
+
+    if (not m_chip.empty())
+    {
+        if (auto line = findOnChip(m_chip); line.has_value())
+        {
+            return *line;
+        }
+
+        throw std::runtime_error(
+            std::format("gpio line \"{}\" not found on \"{}\"", m_line, m_chip.string()));
+    }
+
+    if (auto line = readCache(); line.has_value())
+    {
+        return *line;
+    }
+
+    searched = true;
+
+    if (auto line = search(); line.has_value())
+    {
+        return *line;
+    }
+
+    throw std::runtime_error(std::format("gpio line \"{}\" not found", m_line));
+}
+
+//-------------------------------------------------------------------------
+
+std::optional<GpioLine>
+GpioDiscovery::search() const
+{
+    std::vector<std::filesystem::path> chips;
+
+#if defined(ARGON_MINIMAL_BUILD)
+
+    const auto closeDir = [](DIR* dir) { ::closedir(dir); };
+    const std::unique_ptr<DIR, decltype(closeDir)> dev{::opendir("/dev"), closeDir};
+    if (not dev)
+    {
+        throw std::system_error(errno, std::generic_category(), "opendir");
+    }
+
+    while (const auto entry = ::readdir(dev.get()))
+    {
+        const std::string_view name{entry->d_name};
+        if (name.starts_with("gpiochip"))
+        {
+            std::filesystem::path path{"/dev"};
+            path /= name;
+
+            if (gpiod::is_gpiochip_device(path))
+            {
+                chips.push_back(std::move(path));
+            }
+        }
+    }
+
+#else
+
+    for (const auto& entry : std::filesystem::directory_iterator("/dev"))
+    {
+        if (entry.path().filename().string().starts_with("gpiochip")
+            and gpiod::is_gpiochip_device(entry.path()))
+        {
+            chips.push_back(entry.path());
+        }
+    }
+
+#endif
+
+    std::ranges::sort(chips);
+
+    // Prefer the Raspberry Pi 5 RP1 chip, then take the first chip that
+    // has the line. An offset on its own only makes sense on the RP1.
+
+    const bool byOffset = lineOffset().has_value();
+
+    for (const bool preferred : { true, false })
+    {
+        if (byOffset and not preferred)
+        {
+            break;
+        }
+
+        for (const auto& path : chips)
+        {
+            try
+            {
+                const bool rp1 = (gpiod::chip(path).get_info().label() == c_defaultChipLabel);
+
+                if (rp1 != preferred)
+                {
+                    continue;
+                }
+
+                if (auto line = findOnChip(path); line.has_value())
+                {
+                    return line;
+                }
+            }
+            catch (const std::exception&)
+            {
+                continue;
+            }
+        }
+    }
+
+    return std::nullopt;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+GpioDiscovery::writeCache(
+    const GpioLine& line) const
+{
+    const auto temporary = std::format("{}.tmp", c_cachePath);
+    const auto text = std::format("{} {} {}\n", m_line, line.chip.string(), line.offset);
+
+    {
+        const FileDescriptor fd{::open(
+            temporary.c_str(),
+            O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+            0644)};
+
+        if (not fd.valid()
+            or ::write(fd.get(), text.data(), text.size()) != static_cast<ssize_t>(text.size()))
+        {
+            return false;
+        }
+    }
+
+    return ::rename(temporary.c_str(), c_cachePath.data()) == 0;
+}
+
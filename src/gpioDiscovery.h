@@ -0,0 +1,81 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <gpiod.hpp>
+
+//-------------------------------------------------------------------------
+
+// Finds the gpio line the lid switch is connected to. The line can be
+// given by name (for example GPIO27) or by offset, and the chip by path.
+// If no chip is given, the line is looked up in the cache file and, if it
+// isn't there or is out of date, every gpio chip is searched. Chips are
+// renumbered between kernel versions, so the cache stores the name too.
+
+struct GpioLine
+{
+    std::filesystem::path chip{};
+    gpiod::line::offset offset{0};
+};
+
+class GpioDiscovery
+{
+public:
+
+    static constexpr std::string_view c_defaultChipLabel{"pinctrl-rp1"};
+    static constexpr std::string_view c_defaultLine{"GPIO27"};
+    static constexpr std::string_view c_cachePath{"/run/argonOneUpLidMonitor.gpio"};
+
+    GpioDiscovery(std::filesystem::path chip, std::string line);
+
+    // searched is set if the line had to be searched for, in which case
+    // the result should be cached.
+
+    [[nodiscard]] GpioLine resolve(bool& searched) const;
+    bool writeCache(const GpioLine& line) const;
+
+private:
+
+    [[nodiscard]] std::optional<gpiod::line::offset> lineOffset() const;
+    [[nodiscard]] std::optional<GpioLine> findOnChip(const std::filesystem::path& chip) const;
+    [[nodiscard]] std::optional<GpioLine> readCache() const;
+    [[nodiscard]] std::optional<GpioLine> search() const;
+
+    std::filesystem::path m_chip{};
+    std::string m_line{};
+};
+
+//-------------------------------------------------------------------------
+
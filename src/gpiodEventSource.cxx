@@ -0,0 +1,100 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <utility>
+
+#include "gpiodEventSource.h"
+
+//=========================================================================
+
+GpiodEventSource::GpiodEventSource(
+    gpiod::line_request request,
+    std::size_t bufferSize)
+:
+    m_request{std::move(request)},
+    m_buffer{bufferSize},
+    m_syscalls{0}
+{
+}
+
+//-------------------------------------------------------------------------
+
+int
+GpiodEventSource::fd() const
+{
+    return m_request.fd();
+}
+
+//-------------------------------------------------------------------------
+
+bool
+GpiodEventSource::wait(
+    std::chrono::nanoseconds timeout)
+{
+    ++m_syscalls;
+    return m_request.wait_edge_events(timeout);
+}
+
+//-------------------------------------------------------------------------
+
+std::size_t
+GpiodEventSource::read(
+    std::span<EdgeEvent> events)
+{
+    ++m_syscalls;
+    const auto count = m_request.read_edge_events(
+        m_buffer,
+        std::min(events.size(), m_buffer.capacity()));
+
+    std::ranges::transform(
+        m_buffer,
+        events.begin(),
+        [](const gpiod::edge_event& event)
+        {
+            return EdgeEvent{
+                event.line_offset(),
+                event.type(),
+                event.timestamp_ns(),
+                event.global_seqno(),
+                event.line_seqno() };
+        });
+
+    return count;
+}
+
+//-------------------------------------------------------------------------
+
+gpiod::line::value
+GpiodEventSource::value(
+    gpiod::line::offset offset)
+{
+    ++m_syscalls;
+    return m_request.get_value(offset);
+}
+
+//-------------------------------------------------------------------------
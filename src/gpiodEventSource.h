@@ -0,0 +1,66 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include <gpiod.hpp>
+
+#include "eventSource.h"
+
+//-------------------------------------------------------------------------
+
+// Edges from a libgpiod line request, read in batches into a buffer that
+// is allocated once.
+
+class GpiodEventSource : public EventSource
+{
+public:
+
+    GpiodEventSource(gpiod::line_request request, std::size_t bufferSize);
+
+    [[nodiscard]] int fd() const override;
+    bool wait(std::chrono::nanoseconds timeout) override;
+    std::size_t read(std::span<EdgeEvent> events) override;
+    gpiod::line::value value(gpiod::line::offset offset) override;
+
+    [[nodiscard]] std::uint64_t syscalls() const noexcept override { return m_syscalls; }
+
+private:
+
+    gpiod::line_request m_request;
+    gpiod::edge_event_buffer m_buffer;
+    std::uint64_t m_syscalls{0};
+};
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,135 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <format>
+
+#include "latencyHistogram.h"
+
+//=========================================================================
+
+std::size_t
+LatencyHistogram::bucketIndex(
+    std::uint64_t value) noexcept
+{
+    if (value < c_subBuckets)
+    {
+        return static_cast<std::size_t>(value);
+    }
+
+    const auto msb = static_cast<unsigned>(std::bit_width(value)) - 1;
+    const auto sub = (value >> (msb - c_subBucketBits)) & (c_subBuckets - 1);
+
+    return (msb - c_subBucketBits + 1) * c_subBuckets + static_cast<std::size_t>(sub);
+}
+
+//-------------------------------------------------------------------------
+
+std::uint64_t
+LatencyHistogram::bucketUpperBound(
+    std::size_t index) noexcept
+{
+    if (index < c_subBuckets)
+    {
+        return index;
+    }
+
+    const auto msb = static_cast<unsigned>(index / c_subBuckets) + c_subBucketBits - 1;
+    const auto sub = static_cast<std::uint64_t>(index % c_subBuckets);
+    const auto width = std::uint64_t{1} << (msb - c_subBucketBits);
+
+    return (std::uint64_t{1} << msb) + (sub + 1) * width - 1;
+}
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+LatencyHistogram::percentile(
+    double percent) const noexcept
+{
+    if (m_count == 0)
+    {
+        return std::chrono::nanoseconds{0};
+    }
+
+    const auto target = static_cast<std::uint64_t>(
+        std::ceil(static_cast<double>(m_count) * std::clamp(percent, 0.0, 100.0) / 100.0));
+
+    std::uint64_t cumulative{0};
+
+    for (std::size_t index = 0 ; index < c_buckets ; ++index)
+    {
+        cumulative += m_buckets[index];
+
+        if (cumulative >= std::max<std::uint64_t>(target, 1))
+        {
+            const auto value = std::clamp(bucketUpperBound(index), m_min, m_max);
+            return std::chrono::nanoseconds(value);
+        }
+    }
+
+    return max();
+}
+
+//-------------------------------------------------------------------------
+
+void
+LatencyHistogram::record(
+    std::chrono::nanoseconds latency) noexcept
+{
+    const auto value = static_cast<std::uint64_t>(std::max(latency.count(), std::int64_t{0}));
+
+    ++m_buckets[bucketIndex(value)];
+
+    m_min = (m_count == 0) ? value : std::min(m_min, value);
+    m_max = std::max(m_max, value);
+    m_sum += value;
+    ++m_count;
+}
+
+//-------------------------------------------------------------------------
+
+std::string
+LatencyHistogram::summary() const
+{
+    auto microseconds = [](std::chrono::nanoseconds ns)
+    {
+        return std::chrono::duration<double, std::micro>(ns).count();
+    };
+
+    return std::format(
+        "count {} min {:.1f}us p50 {:.1f}us p90 {:.1f}us p99 {:.1f}us max {:.1f}us",
+        m_count,
+        microseconds(min()),
+        microseconds(percentile(50)),
+        microseconds(percentile(90)),
+        microseconds(percentile(99)),
+        microseconds(max()));
+}
+
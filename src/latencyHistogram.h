@@ -0,0 +1,77 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+//-------------------------------------------------------------------------
+
+// A log bucketed latency histogram in the style of HdrHistogram. Each power
+// of two is split into c_subBuckets linear buckets, so any recorded value
+// is reported to within 25% using a fixed 2KB table and no allocation.
+
+class LatencyHistogram
+{
+public:
+
+    static constexpr unsigned c_subBucketBits{2};
+    static constexpr std::size_t c_subBuckets{1U << c_subBucketBits};
+    static constexpr std::size_t c_buckets{(64 - c_subBucketBits + 1) * c_subBuckets};
+
+    void record(std::chrono::nanoseconds latency) noexcept;
+    void reset() noexcept { *this = LatencyHistogram{}; }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return m_count; }
+    [[nodiscard]] std::chrono::nanoseconds max() const noexcept { return std::chrono::nanoseconds(m_max); }
+    [[nodiscard]] std::chrono::nanoseconds min() const noexcept { return std::chrono::nanoseconds(m_min); }
+    [[nodiscard]] std::chrono::nanoseconds percentile(double percent) const noexcept;
+    [[nodiscard]] std::chrono::nanoseconds sum() const noexcept { return std::chrono::nanoseconds(m_sum); }
+    [[nodiscard]] std::string summary() const;
+
+    [[nodiscard]] const std::array<std::uint64_t, c_buckets>& buckets() const noexcept { return m_buckets; }
+
+    static std::size_t bucketIndex(std::uint64_t value) noexcept;
+    static std::uint64_t bucketUpperBound(std::size_t index) noexcept;
+
+private:
+
+    std::array<std::uint64_t, c_buckets> m_buckets{};
+    std::uint64_t m_count{0};
+    std::uint64_t m_min{0};
+    std::uint64_t m_max{0};
+    std::uint64_t m_sum{0};
+};
+
+//-------------------------------------------------------------------------
+
@@ -0,0 +1,206 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+//-------------------------------------------------------------------------
+
+// The lid state machine as a table built at compile time. The input is
+// the state the lid switch has settled in, after debounce, and each entry
+// gives the next state and the actions to take. Adding a state means
+// adding its name and a row and column to the table, and the checks at
+// the end of this file catch anything that has been missed.
+
+enum class LidState : std::uint8_t
+{
+    UNKNOWN,
+    OPEN,
+    CLOSED
+};
+
+inline constexpr std::size_t c_lidStateCount{3};
+
+inline constexpr std::array<std::string_view, c_lidStateCount> c_lidStateNames
+{
+    "unknown",
+    "open",
+    "closed"
+};
+
+[[nodiscard]] constexpr std::string_view
+lidStateName(
+    LidState state) noexcept
+{
+    const auto index = static_cast<std::size_t>(state);
+
+    return (index < c_lidStateNames.size()) ? c_lidStateNames[index] : c_lidStateNames[0];
+}
+
+//-------------------------------------------------------------------------
+
+enum class LidAction : std::uint8_t
+{
+    NONE = 0,
+    LOG_STATE = 1 << 0,
+    COUNT_OPENED = 1 << 1,
+    COUNT_CLOSED = 1 << 2,
+    ARM_COUNTDOWN = 1 << 3,
+    CANCEL_COUNTDOWN = 1 << 4
+};
+
+[[nodiscard]] constexpr LidAction
+operator|(
+    LidAction lhs,
+    LidAction rhs) noexcept
+{
+    return static_cast<LidAction>(static_cast<std::uint8_t>(lhs) | static_cast<std::uint8_t>(rhs));
+}
+
+[[nodiscard]] constexpr bool
+hasAction(
+    LidAction actions,
+    LidAction action) noexcept
+{
+    return (static_cast<std::uint8_t>(actions) & static_cast<std::uint8_t>(action)) != 0;
+}
+
+//-------------------------------------------------------------------------
+
+struct LidTransition
+{
+    LidState next{LidState::UNKNOWN};
+    LidAction actions{LidAction::NONE};
+};
+
+using LidTransitionTable = std::array<std::array<LidTransition, c_lidStateCount>, c_lidStateCount>;
+
+// Indexed by [current state][input].
+
+inline constexpr LidTransitionTable c_lidTransitions
+{{
+    // from UNKNOWN
+    {{
+        { LidState::UNKNOWN, LidAction::NONE },
+        { LidState::OPEN, LidAction::LOG_STATE | LidAction::COUNT_OPENED },
+        { LidState::CLOSED, LidAction::LOG_STATE | LidAction::COUNT_CLOSED | LidAction::ARM_COUNTDOWN }
+    }},
+    // from OPEN
+    {{
+        { LidState::UNKNOWN, LidAction::LOG_STATE },
+        { LidState::OPEN, LidAction::NONE },
+        { LidState::CLOSED, LidAction::LOG_STATE | LidAction::COUNT_CLOSED | LidAction::ARM_COUNTDOWN }
+    }},
+    // from CLOSED
+    {{
+        { LidState::UNKNOWN, LidAction::LOG_STATE | LidAction::CANCEL_COUNTDOWN },
+        { LidState::OPEN, LidAction::LOG_STATE | LidAction::COUNT_OPENED | LidAction::CANCEL_COUNTDOWN },
+        { LidState::CLOSED, LidAction::NONE }
+    }}
+}};
+
+[[nodiscard]] constexpr const LidTransition&
+lidTransition(
+    LidState current,
+    LidState input) noexcept
+{
+    return c_lidTransitions[static_cast<std::size_t>(current)][static_cast<std::size_t>(input)];
+}
+
+//-------------------------------------------------------------------------
+
+// Checked when compiled, so that a new state cannot be half added.
+
+static_assert(static_cast<std::size_t>(LidState::CLOSED) + 1 == c_lidStateCount);
+
+static_assert(
+    []
+    {
+        for (const auto name : c_lidStateNames)
+        {
+            if (name.empty())
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }(),
+    "every lid state needs a name");
+
+static_assert(
+    []
+    {
+        for (std::size_t current = 0 ; current < c_lidStateCount ; ++current)
+        {
+            for (std::size_t input = 0 ; input < c_lidStateCount ; ++input)
+            {
+                const auto& transition = c_lidTransitions[current][input];
+
+                if (static_cast<std::size_t>(transition.next) != input or
+                    (current == input) != (transition.actions == LidAction::NONE) or
+                    (current != input and not hasAction(transition.actions, LidAction::LOG_STATE)))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }(),
+    "the lid follows the switch and only logs a change of state");
+
+static_assert(
+    []
+    {
+        for (std::size_t current = 0 ; current < c_lidStateCount ; ++current)
+        {
+            for (std::size_t input = 0 ; input < c_lidStateCount ; ++input)
+            {
+                const auto& transition = c_lidTransitions[current][input];
+                const bool wasClosed = static_cast<LidState>(current) == LidState::CLOSED;
+                const bool isClosed = transition.next == LidState::CLOSED;
+
+                if (hasAction(transition.actions, LidAction::ARM_COUNTDOWN) != (isClosed and not wasClosed) or
+                    hasAction(transition.actions, LidAction::CANCEL_COUNTDOWN) != (wasClosed and not isClosed))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }(),
+    "the countdown is armed on entering closed and cancelled on leaving it");
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,676 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <pthread.h>
+#include <syslog.h>
+#include <sys/uio.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <systemd/sd-journal.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <format>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <utility>
+
+#include "logger.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+constexpr std::array<std::string_view, 8> c_priorityNames
+{
+    "emergency",
+    "alert",
+    "critical",
+    "error",
+    "warning",
+    "notice",
+    "info",
+    "debug"
+};
+
+constexpr std::size_t c_maxBatch{16};
+constexpr std::string_view c_ellipsis{"\u2026"};
+
+//-------------------------------------------------------------------------
+
+struct EventDescription
+{
+    std::string_view messageId;
+    std::string_view message;
+};
+
+constexpr std::array<EventDescription, 4> c_events
+{
+    EventDescription{ "", "" },
+    EventDescription{ "MESSAGE_ID=70eab69801104fcea372283669a94022", "lid " },
+    EventDescription{ "MESSAGE_ID=564a4df1964544e0be4650151b831f8d", "shutdown armed" },
+    EventDescription{ "MESSAGE_ID=9cf7d9a290ff4a2f80f53625e3981bf6", "shutdown cancelled" }
+};
+
+//-------------------------------------------------------------------------
+
+// Append "NAME=value" to buffer, returning the field as an iovec.
+
+iovec
+numberField(
+    std::span<char> buffer,
+    std::string_view name,
+    std::uint64_t value)
+{
+    auto next = std::ranges::copy(name, buffer.data()).out;
+    next = std::to_chars(next, buffer.data() + buffer.size(), value).ptr;
+
+    return iovec{ buffer.data(), static_cast<std::size_t>(next - buffer.data()) };
+}
+
+//-------------------------------------------------------------------------
+
+iovec
+viewField(
+    std::string_view field)
+{
+    return iovec{ const_cast<char*>(field.data()), field.size() };
+}
+
+//-------------------------------------------------------------------------
+
+// Copy message into text, which has room for c_maxMessageLength characters
+// and the terminator. A message that does not fit is cut at a character
+// boundary and ends with an ellipsis. Returns the length copied and
+// whether the message was truncated.
+
+std::pair<std::uint16_t, bool>
+copyMessage(
+    std::string_view message,
+    char* text) noexcept
+{
+    if (message.size() <= Logger::c_maxMessageLength)
+    {
+        std::ranges::copy(message, text);
+        text[message.size()] = '\0';
+
+        return { static_cast<std::uint16_t>(message.size()), false };
+    }
+
+    auto length = Logger::c_maxMessageLength - c_ellipsis.size();
+    while (length > 0 and (static_cast<unsigned char>(message[length]) & 0xC0) == 0x80)
+    {
+        --length;
+    }
+
+    auto next = std::ranges::copy_n(message.data(), length, text).out;
+    next = std::ranges::copy(c_ellipsis, next).out;
+    *next = '\0';
+
+    return { static_cast<std::uint16_t>(next - text), true };
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+Logger::Logger()
+:
+    Logger(::getenv("JOURNAL_STREAM") != nullptr)
+{
+}
+
+//-------------------------------------------------------------------------
+
+Logger::Logger(
+    bool journal)
+:
+    m_journal{journal},
+    m_maxPriority{LOG_INFO},
+    m_running{false},
+    m_zone{nullptr},
+    m_hostname{},
+    m_programName{},
+    m_records{},
+    m_enqueuePosition{0},
+    m_dequeuePosition{0},
+    m_available{0},
+    m_dropped{0},
+    m_truncated{0},
+    m_writes{0},
+    m_thread{}
+{
+    for (std::size_t i = 0 ; i < c_capacity ; ++i)
+    {
+        m_records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+Logger::~Logger()
+{
+    stop();
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::log(
+    int priority,
+    std::string_view message) noexcept
+{
+    if (enabled(priority))
+    {
+        submit(priority, message, LogEvent::NONE, LogFields{});
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::logEvent(
+    int priority,
+    LogEvent event,
+    const LogFields& fields) noexcept
+{
+    if (enabled(priority))
+    {
+        submit(priority, {}, event, fields);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+bool
+Logger::push(
+    int priority,
+    std::string_view message,
+    LogEvent event,
+    const LogFields& fields) noexcept
+{
+    auto position = m_enqueuePosition.load(std::memory_order_relaxed);
+    Record* record{nullptr};
+
+    for (;;)
+    {
+        record = &m_records[position % c_capacity];
+        const auto sequence = record->sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::intptr_t>(sequence)
+                              - static_cast<std::intptr_t>(position);
+
+        if (difference == 0)
+        {
+            if (m_enqueuePosition.compare_exchange_weak(
+                    position,
+                    position + 1,
+                    std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (difference < 0)
+        {
+            return false;
+        }
+        else
+        {
+            position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->time = std::chrono::system_clock::now();
+    record->priority = priority;
+    record->event = event;
+    record->fields = fields;
+    bool truncated{false};
+    std::tie(record->length, truncated) = copyMessage(message, record->text.data());
+
+    if (truncated)
+    {
+        m_truncated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    record->sequence.store(position + 1, std::memory_order_release);
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::render(
+    Record& record) const
+{
+    // Build the text of an event record. This is done on the sink thread
+    // so that callers never format anything.
+
+    if (record.event == LogEvent::NONE)
+    {
+        return;
+    }
+
+    const auto& description = c_events[static_cast<std::size_t>(record.event)];
+    const auto first = record.text.data();
+    const auto last = first + c_maxMessageLength;
+
+    auto next = std::ranges::copy(description.message, first).out;
+
+    if (record.event == LogEvent::LID_STATE)
+    {
+        const auto length = std::min<std::ptrdiff_t>(std::ssize(record.fields.lidState), last - next);
+        next = std::ranges::copy_n(record.fields.lidState.data(), length, next).out;
+    }
+
+    *next = '\0';
+    record.length = static_cast<std::uint16_t>(next - first);
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::setIdentity(
+    std::string_view hostname,
+    std::string_view programName)
+{
+    m_hostname = hostname;
+    m_programName = programName;
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::sink(
+    std::stop_token stopToken)
+{
+    for (;;)
+    {
+        const auto available = m_available.load(std::memory_order_acquire);
+
+        if (writeBatch() == 0)
+        {
+            if (stopToken.stop_requested())
+            {
+                break;
+            }
+
+            m_available.wait(available, std::memory_order_acquire);
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::submit(
+    int priority,
+    std::string_view message,
+    LogEvent event,
+    const LogFields& fields) noexcept
+{
+    if (not m_running.load(std::memory_order_acquire))
+    {
+        Record record;
+        record.time = std::chrono::system_clock::now();
+        record.priority = priority;
+        record.event = event;
+        record.fields = fields;
+        bool truncated{false};
+        std::tie(record.length, truncated) = copyMessage(message, record.text.data());
+        render(record);
+
+        if (truncated)
+        {
+            m_truncated.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        m_writes.fetch_add(1, std::memory_order_relaxed);
+
+        if (m_journal)
+        {
+            writeJournal(record);
+        }
+        else
+        {
+            const Record* records[]{ &record };
+            writeStderr(records, 1);
+        }
+
+        return;
+    }
+
+    if (push(priority, message, event, fields))
+    {
+        m_available.fetch_add(1, std::memory_order_release);
+        m_available.notify_one();
+    }
+    else
+    {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::start()
+{
+    if (not m_thread.joinable())
+    {
+        m_thread = std::jthread([this](std::stop_token stopToken) { sink(stopToken); });
+        m_running.store(true, std::memory_order_release);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::stop()
+{
+    if (m_thread.joinable())
+    {
+        // Only switch to synchronous writes once the sink thread has gone,
+        // as both use the hostname and time zone caches.
+
+        m_thread.request_stop();
+        m_available.fetch_add(1, std::memory_order_release);
+        m_available.notify_one();
+        m_thread.join();
+        m_running.store(false, std::memory_order_release);
+
+        while (writeBatch() > 0)
+        {
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::size_t
+Logger::writeBatch()
+{
+    std::array<const Record*, c_maxBatch> records;
+    std::size_t count{0};
+
+    while (count < c_maxBatch)
+    {
+        const auto position = m_dequeuePosition + count;
+        const auto& record = m_records[position % c_capacity];
+
+        if (record.sequence.load(std::memory_order_acquire) != position + 1)
+        {
+            break;
+        }
+
+        render(m_records[position % c_capacity]);
+        records[count++] = &record;
+    }
+
+    if (count == 0)
+    {
+        return 0;
+    }
+
+    // One system call per record for the journal, one for the batch for
+    // stderr.
+
+    m_writes.fetch_add(m_journal ? count : 1, std::memory_order_relaxed);
+
+    if (m_journal)
+    {
+        for (const auto record : records | std::views::take(count))
+        {
+            writeJournal(*record);
+        }
+    }
+    else
+    {
+        writeStderr(records.data(), count);
+    }
+
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        const auto position = m_dequeuePosition++;
+        m_records[position % c_capacity].sequence.store(
+            position + c_capacity,
+            std::memory_order_release);
+    }
+
+    return count;
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::writeJournal(
+    const Record& record) const
+{
+    if (record.event == LogEvent::NONE)
+    {
+        sd_journal_print(record.priority, "%.*s", record.length, record.text.data());
+        return;
+    }
+
+    constexpr std::size_t maxFieldLength{48};
+    constexpr std::size_t maxFields{7};
+
+    std::array<std::array<char, maxFieldLength>, maxFields> buffers;
+    std::array<iovec, maxFields> iov;
+    std::size_t count{0};
+
+    const auto& description = c_events[static_cast<std::size_t>(record.event)];
+    const auto& fields = record.fields;
+
+    constexpr std::string_view messagePrefix{"MESSAGE="};
+    std::array<char, messagePrefix.size() + c_maxMessageLength> message;
+    auto next = std::ranges::copy(messagePrefix, message.data()).out;
+    next = std::ranges::copy_n(record.text.data(), record.length, next).out;
+
+    iov[count++] = iovec{ message.data(), static_cast<std::size_t>(next - message.data()) };
+    iov[count++] = viewField(description.messageId);
+    iov[count] = numberField(buffers[count], "PRIORITY=", static_cast<std::uint64_t>(record.priority));
+    ++count;
+
+    if (not fields.lidState.empty())
+    {
+        constexpr std::string_view name{"LID_STATE="};
+        auto last = std::ranges::copy(name, buffers[count].data()).out;
+        const auto length = std::min(fields.lidState.size(), maxFieldLength - name.size());
+        last = std::ranges::copy_n(fields.lidState.data(), length, last).out;
+        iov[count] = iovec{ buffers[count].data(), static_cast<std::size_t>(last - buffers[count].data()) };
+        ++count;
+    }
+
+    if (fields.eventTimestampNs != 0)
+    {
+        iov[count] = numberField(buffers[count], "EVENT_TIMESTAMP_NS=", fields.eventTimestampNs);
+        ++count;
+    }
+
+    if (fields.lineSeqno != 0)
+    {
+        iov[count] = numberField(buffers[count], "LINE_SEQNO=", fields.lineSeqno);
+        ++count;
+    }
+
+    if (fields.shutdownDeadlineUsec != 0)
+    {
+        iov[count] = numberField(buffers[count], "SHUTDOWN_DEADLINE=", fields.shutdownDeadlineUsec);
+        ++count;
+    }
+
+    sd_journal_sendv(iov.data(), static_cast<int>(count));
+}
+
+//-------------------------------------------------------------------------
+
+void
+Logger::writeStderr(
+    const Record* const* records,
+    std::size_t count) const
+{
+    constexpr std::size_t maxPrefixLength{128};
+    std::array<std::array<char, maxPrefixLength>, c_maxBatch> prefixes;
+    std::array<iovec, 3 * c_maxBatch> iov;
+    static char newline{'\n'};
+
+    const auto pid = ::getpid();
+    std::size_t iovCount{0};
+
+    for (std::size_t i = 0 ; i < count ; ++i)
+    {
+        const auto& record = *records[i];
+        auto& prefix = prefixes[i];
+
+#if defined(ARGON_MINIMAL_BUILD)
+
+        // localtime_r only reads /etc/localtime, where current_zone()
+        // loads the whole tz database.
+
+        const auto seconds = std::chrono::system_clock::to_time_t(record.time);
+        tm localTime{};
+        ::localtime_r(&seconds, &localTime);
+
+        std::array<char, 32> time{};
+        const auto timeLength = ::strftime(time.data(), time.size(), "%b %e %T", &localTime);
+
+        auto result = std::format_to_n(
+            prefix.data(),
+            prefix.size(),
+            "{} {} {}[{}]:",
+            std::string_view(time.data(), timeLength),
+            hostname(),
+            m_programName,
+            pid);
+
+#else
+
+        const auto seconds = floor<std::chrono::seconds>(record.time);
+        const auto localTime = zone()->to_local(seconds);
+
+        auto result = std::format_to_n(
+            prefix.data(),
+            prefix.size(),
+            "{:%b %e %T} {} {}[{}]:",
+            localTime,
+            hostname(),
+            m_programName,
+            pid);
+
+#endif
+
+        const auto used = static_cast<std::size_t>(result.out - prefix.data());
+
+        if (record.priority >= 0 and record.priority < std::ssize(c_priorityNames))
+        {
+            result = std::format_to_n(
+                result.out,
+                prefix.size() - used,
+                "{}:",
+                c_priorityNames[record.priority]);
+        }
+        else
+        {
+            result = std::format_to_n(
+                result.out,
+                prefix.size() - used,
+                "unknown({}):",
+                record.priority);
+        }
+
+        const auto length = std::min(
+            static_cast<std::size_t>(result.out - prefix.data()),
+            prefix.size());
+
+        iov[iovCount++] = iovec{ prefix.data(), length };
+        iov[iovCount++] = iovec{ const_cast<char*>(record.text.data()), record.length };
+        iov[iovCount++] = iovec{ &newline, 1 };
+    }
+
+    ::writev(STDERR_FILENO, iov.data(), static_cast<int>(iovCount));
+}
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+Logger::cpuTime()
+{
+    clockid_t clock{};
+    timespec ts{};
+
+    if (not m_thread.joinable() or
+        ::pthread_getcpuclockid(m_thread.native_handle(), &clock) != 0 or
+        ::clock_gettime(clock, &ts) == -1)
+    {
+        return std::chrono::nanoseconds{0};
+    }
+
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+//-------------------------------------------------------------------------
+
+const std::string&
+Logger::hostname() const
+{
+    if (m_hostname.empty())
+    {
+        char hostname[256]{};
+        if (::gethostname(hostname, sizeof(hostname) - 1) == 0)
+        {
+            m_hostname = hostname;
+        }
+        else
+        {
+            m_hostname = "localhost";
+        }
+    }
+
+    return m_hostname;
+}
+
+//-------------------------------------------------------------------------
+
+const std::chrono::time_zone*
+Logger::zone() const
+{
+    if (m_zone == nullptr)
+    {
+        m_zone = std::chrono::current_zone();
+    }
+
+    return m_zone;
+}
+
@@ -0,0 +1,155 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <syslog.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <thread>
+
+//-------------------------------------------------------------------------
+
+// Events logged with structured journal fields rather than free text. Each
+// has its own MESSAGE_ID so that journal readers can filter on it.
+
+enum class LogEvent : std::uint8_t
+{
+    NONE,
+    LID_STATE,
+    SHUTDOWN_ARMED,
+    SHUTDOWN_CANCELLED
+};
+
+// Fields that are zero (or empty) are not sent. lidState must refer to
+// storage that outlives the logger, such as a string literal.
+
+struct LogFields
+{
+    std::string_view lidState{};
+    std::uint64_t eventTimestampNs{0};
+    std::uint64_t lineSeqno{0};
+    std::uint64_t shutdownDeadlineUsec{0};
+};
+
+//-------------------------------------------------------------------------
+
+// Asynchronous logger. Callers copy their message into a fixed size record
+// in a lock-free bounded MPSC ring and return straight away. A background
+// thread formats the records and writes them to the sink, which is chosen
+// once at construction: by default the journal if stderr is connected to
+// it, stderr otherwise. Until start() is called messages are written
+// synchronously. Messages longer than c_maxMessageLength are cut short,
+// end with an ellipsis and are counted by truncated(). Messages less
+// important than the maximum priority, LOG_INFO by default, are dropped
+// without being copied, and callers can check enabled() to avoid
+// formatting them at all. Unless given to
+// setIdentity(), the hostname is looked up when the first message is
+// written to stderr, as is the time zone, since the journal sink needs
+// neither.
+
+class Logger
+{
+public:
+
+    static constexpr std::size_t c_capacity{256};
+    static constexpr std::size_t c_maxMessageLength{200};
+
+    Logger();
+    explicit Logger(bool journal);
+    ~Logger();
+
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    void log(int priority, std::string_view message) noexcept;
+    void logEvent(int priority, LogEvent event, const LogFields& fields) noexcept;
+    void setIdentity(std::string_view hostname, std::string_view programName);
+    void setMaxPriority(int priority) noexcept { m_maxPriority = priority; }
+    void start();
+    void stop();
+
+    [[nodiscard]] bool enabled(int priority) const noexcept { return priority <= m_maxPriority; }
+    [[nodiscard]] std::uint64_t dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t truncated() const noexcept { return m_truncated.load(std::memory_order_relaxed); }
+    [[nodiscard]] std::uint64_t writes() const noexcept { return m_writes.load(std::memory_order_relaxed); }
+
+    // The cpu time used by the background thread, zero if not started.
+
+    [[nodiscard]] std::chrono::nanoseconds cpuTime();
+    [[nodiscard]] bool journal() const noexcept { return m_journal; }
+
+private:
+
+    struct alignas(64) Record
+    {
+        std::atomic<std::size_t> sequence{0};
+        std::chrono::system_clock::time_point time{};
+        int priority{0};
+        LogEvent event{LogEvent::NONE};
+        LogFields fields{};
+        std::uint16_t length{0};
+        std::array<char, c_maxMessageLength + 1> text{};
+    };
+
+    bool push(int priority, std::string_view message, LogEvent event, const LogFields& fields) noexcept;
+    void render(Record& record) const;
+    void sink(std::stop_token stopToken);
+    void submit(int priority, std::string_view message, LogEvent event, const LogFields& fields) noexcept;
+    std::size_t writeBatch();
+    void writeJournal(const Record& record) const;
+    void writeStderr(const Record* const* records, std::size_t count) const;
+
+    const std::string& hostname() const;
+    const std::chrono::time_zone* zone() const;
+
+    bool m_journal{false};
+    int m_maxPriority{LOG_INFO};
+    std::atomic<bool> m_running{false};
+    mutable const std::chrono::time_zone* m_zone{nullptr};
+    mutable std::string m_hostname{};
+    std::string m_programName{};
+    std::array<Record, c_capacity> m_records{};
+    alignas(64) std::atomic<std::size_t> m_enqueuePosition{0};
+    alignas(64) std::size_t m_dequeuePosition{0};
+    std::atomic<std::uint32_t> m_available{0};
+    std::atomic<std::uint64_t> m_dropped{0};
+    std::atomic<std::uint64_t> m_truncated{0};
+    std::atomic<std::uint64_t> m_writes{0};
+    std::jthread m_thread{};
+};
+
+//-------------------------------------------------------------------------
+
@@ -25,6 +25,7 @@
 //
 //-------------------------------------------------------------------------
 
+#include <pthread.h>
 #include <syslog.h>
 
 #include <atomic>
@@ -43,43 +44,22 @@ static std::atomic<bool> s_run{true};
 
 //-------------------------------------------------------------------------
 
-static void
-signalHandler(
-    int signalNumber) noexcept
-{
-    switch (signalNumber)
-    {
-    case SIGINT:
-    case SIGTERM:
-
-        s_run = false;
-        break;
-    };
-}
-
-//-------------------------------------------------------------------------
-
 void
-setSignalHandler(
+blockSignals(
     const ArgonOneUpLidMonitor& monitor)
 {
-    for (auto signal : { SIGINT, SIGTERM })
+    // The signals are delivered through a signalfd in the event loop, so
+    // they must be blocked before any other thread is started.
+
+    const auto signals = ArgonOneUpLidMonitor::handledSignals();
+
+    if (const int error = ::pthread_sigmask(SIG_BLOCK, &signals, nullptr); error != 0)
     {
-        struct sigaction sa{};
-        sa.sa_handler = signalHandler;
-        sa.sa_flags = 0;
-
-        if (sigaction(signal, &sa, nullptr) == -1)
-        {
-            monitor.messageLog(
-                LOG_ERR,
-                std::format(
-                    "cannot install {} signal handler : {}",
-                    strsignal(signal),
-                    strerror(errno)));
-
-            ::exit(EXIT_FAILURE);
-        }
+        monitor.messageLog(
+            LOG_ERR,
+            std::format("cannot block signals : {}", strerror(error)));
+
+        ::exit(EXIT_FAILURE);
     }
 }
 
@@ -100,7 +80,7 @@ main(
 
     //---------------------------------------------------------------------
 
-    setSignalHandler(monitor);
+    blockSignals(monitor);
 
     //---------------------------------------------------------------------
 
@@ -113,6 +93,7 @@ main(
         monitor.messageLog(LOG_ERR, std::format("exception caught: {}", e.what()));
     }
 
+    monitor.logUsage();
     monitor.messageLog(LOG_INFO, "exiting");
 }
 
@@ -0,0 +1,231 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <unistd.h>
+
+#include <array>
+#include <chrono>
+#include <format>
+#include <iterator>
+
+#include "fileDescriptor.h"
+#include "lidStateMachine.h"
+#include "metrics.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+// Export the histograms with a bucket for each power of two from 512ns to
+// about 68s. The finer internal buckets are summed into these.
+
+constexpr unsigned c_firstExportedPower{9};
+constexpr unsigned c_lastExportedPower{36};
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+MetricsExporter::MetricsExporter(
+    std::filesystem::path path)
+:
+    m_path{std::move(path)},
+    m_temporaryPath{},
+    m_buffer{}
+{
+    if (enabled())
+    {
+        m_temporaryPath = m_path;
+        m_temporaryPath += ".tmp";
+        m_buffer.reserve(8192);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+MetricsExporter::format(
+    const Metrics& metrics)
+{
+    auto out = std::back_inserter(m_buffer);
+
+    auto counter = [&out](std::string_view name, std::string_view help, std::uint64_t value)
+    {
+        std::format_to(out, "# HELP {} {}\n# TYPE {} counter\n{} {}\n", name, help, name, name, value);
+    };
+
+    counter("argononeup_lid_opened_total", "Number of times the lid has been opened.", metrics.lidOpened);
+    counter("argononeup_lid_closed_total", "Number of times the lid has been closed.", metrics.lidClosed);
+    counter("argononeup_shutdown_armed_total", "Number of shutdown timers armed.", metrics.shutdownArmed);
+    counter("argononeup_shutdown_cancelled_total", "Number of shutdown timers cancelled.", metrics.shutdownCancelled);
+    counter("argononeup_shutdown_fired_total", "Number of lid closed countdowns that reached their last step.", metrics.shutdownFired);
+    counter("argononeup_debounce_suppressed_total", "Number of gpio edges suppressed by debounce.", metrics.debounceSuppressed);
+    counter("argononeup_edge_gaps_total", "Number of gaps in the gpio edge sequence numbers.", metrics.edgeGaps);
+    counter("argononeup_edges_missed_total", "Number of gpio edges dropped by the kernel before they were read.", metrics.edgesMissed);
+    counter("argononeup_log_dropped_total", "Number of log messages dropped because the log queue was full.", metrics.logDropped);
+    counter("argononeup_log_truncated_total", "Number of log messages cut short to fit a log record.", metrics.logTruncated);
+
+    counter("argononeup_wakeups_total", "Number of times the event loop woke up.", metrics.wakeups);
+
+    std::format_to(
+        out,
+        "# HELP argononeup_syscalls_total Number of system calls made, by what they were for.\n"
+        "# TYPE argononeup_syscalls_total counter\n"
+        "argononeup_syscalls_total{{category=\"gpio\"}} {}\n"
+        "argononeup_syscalls_total{{category=\"log\"}} {}\n"
+        "argononeup_syscalls_total{{category=\"timer\"}} {}\n"
+        "argononeup_syscalls_total{{category=\"spawn\"}} {}\n",
+        metrics.gpioSyscalls,
+        metrics.logSyscalls,
+        metrics.timerSyscalls,
+        metrics.spawnSyscalls);
+
+    std::format_to(
+        out,
+        "# HELP argononeup_cpu_seconds_total Cpu time used, by thread.\n"
+        "# TYPE argononeup_cpu_seconds_total counter\n"
+        "argononeup_cpu_seconds_total{{thread=\"main\"}} {}\n"
+        "argononeup_cpu_seconds_total{{thread=\"logger\"}} {}\n",
+        std::chrono::duration<double>(metrics.mainCpu).count(),
+        std::chrono::duration<double>(metrics.loggerCpu).count());
+
+    std::format_to(
+        out,
+        "# HELP argononeup_lid_state Current lid state.\n"
+        "# TYPE argononeup_lid_state gauge\n");
+
+    for (const auto state : c_lidStateNames)
+    {
+        std::format_to(
+            out,
+            "argononeup_lid_state{{state=\"{}\"}} {}\n",
+            state,
+            (state == metrics.lidState) ? 1 : 0);
+    }
+
+    formatHistogram(
+        "argononeup_edge_dispatch_latency_seconds",
+        "Time from the kernel timestamping a gpio edge to it being handled.",
+        metrics.dispatchLatency);
+    formatHistogram(
+        "argononeup_shutdown_arm_latency_seconds",
+        "Time from the lid closing to the shutdown timer being armed.",
+        metrics.armLatency);
+}
+
+//-------------------------------------------------------------------------
+
+void
+MetricsExporter::formatHistogram(
+    std::string_view name,
+    std::string_view help,
+    const LatencyHistogram& histogram)
+{
+    auto out = std::back_inserter(m_buffer);
+
+    std::format_to(out, "# HELP {} {}\n# TYPE {} histogram\n", name, help, name);
+
+    const auto& buckets = histogram.buckets();
+    std::uint64_t cumulative{0};
+    std::size_t index{0};
+
+    for (auto power = c_firstExportedPower ; power <= c_lastExportedPower ; ++power)
+    {
+        // All values below 2^power are in buckets before the first
+        // bucket of that power.
+
+        const auto limit = LatencyHistogram::bucketIndex(std::uint64_t{1} << power);
+
+        for ( ; index < limit ; ++index)
+        {
+            cumulative += buckets[index];
+        }
+
+        const double le = static_cast<double>(std::uint64_t{1} << power) / 1e9;
+        std::format_to(out, "{}_bucket{{le=\"{:g}\"}} {}\n", name, le, cumulative);
+    }
+
+    std::format_to(out, "{}_bucket{{le=\"+Inf\"}} {}\n", name, histogram.count());
+
+    const auto sum = std::chrono::duration<double>(histogram.sum()).count();
+    std::format_to(out, "{}_sum {}\n{}_count {}\n", name, sum, name, histogram.count());
+}
+
+//-------------------------------------------------------------------------
+
+std::string_view
+MetricsExporter::text(
+    const Metrics& metrics)
+{
+    m_buffer.clear();
+    format(metrics);
+
+    return m_buffer;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+MetricsExporter::write(
+    const Metrics& metrics)
+{
+    if (not enabled())
+    {
+        return true;
+    }
+
+    m_buffer.clear();
+    format(metrics);
+
+    {
+        const FileDescriptor fd{::open(
+            m_temporaryPath.c_str(),
+            O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC,
+            0644)};
+
+        if (not fd.valid())
+        {
+            return false;
+        }
+
+        if (::write(fd.get(), m_buffer.data(), m_buffer.size())
+            != static_cast<ssize_t>(m_buffer.size()))
+        {
+            return false;
+        }
+    }
+
+    return ::rename(m_temporaryPath.c_str(), m_path.c_str()) == 0;
+}
+
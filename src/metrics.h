@@ -0,0 +1,107 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+#include "latencyHistogram.h"
+
+//-------------------------------------------------------------------------
+
+struct Metrics
+{
+    std::uint64_t lidOpened{0};
+    std::uint64_t lidClosed{0};
+    std::uint64_t shutdownArmed{0};
+    std::uint64_t shutdownCancelled{0};
+    std::uint64_t shutdownFired{0};
+    std::uint64_t debounceSuppressed{0};
+    std::uint64_t edgeGaps{0};
+    std::uint64_t edgesMissed{0};
+    std::uint64_t logDropped{0};
+    std::uint64_t logTruncated{0};
+
+    // What the service costs: event loop wakeups, system calls by what
+    // they were for, and the cpu time of each thread.
+
+    std::uint64_t wakeups{0};
+    std::uint64_t gpioSyscalls{0};
+    std::uint64_t logSyscalls{0};
+    std::uint64_t timerSyscalls{0};
+    std::uint64_t spawnSyscalls{0};
+    std::chrono::nanoseconds mainCpu{0};
+    std::chrono::nanoseconds loggerCpu{0};
+
+    std::string_view lidState{};
+    LatencyHistogram dispatchLatency{};
+    LatencyHistogram armLatency{};
+};
+
+//-------------------------------------------------------------------------
+
+// Writes the metrics in the Prometheus text format for the node_exporter
+// textfile collector. The text is formatted into a buffer that is reused
+// between writes, written to a temporary file and renamed over the
+// previous one, so the collector never sees a partial file.
+
+class MetricsExporter
+{
+public:
+
+    explicit MetricsExporter(std::filesystem::path path);
+
+    [[nodiscard]] bool enabled() const noexcept { return not m_path.empty(); }
+    [[nodiscard]] const std::filesystem::path& path() const noexcept { return m_path; }
+
+    bool write(const Metrics& metrics);
+
+    // The metrics as they would be written, valid until the next call.
+
+    [[nodiscard]] std::string_view text(const Metrics& metrics);
+
+private:
+
+    void format(const Metrics& metrics);
+    void formatHistogram(
+        std::string_view name,
+        std::string_view help,
+        const LatencyHistogram& histogram);
+
+    std::filesystem::path m_path{};
+    std::filesystem::path m_temporaryPath{};
+    std::string m_buffer{};
+};
+
+//-------------------------------------------------------------------------
+
@@ -0,0 +1,289 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <utility>
+
+#include "monitoredLine.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+constexpr std::array c_edgeNames
+{
+    std::pair{ std::string_view{"both"}, gpiod::line::edge::BOTH },
+    std::pair{ std::string_view{"falling"}, gpiod::line::edge::FALLING },
+    std::pair{ std::string_view{"rising"}, gpiod::line::edge::RISING }
+};
+
+constexpr std::array c_biasNames
+{
+    std::pair{ std::string_view{"as-is"}, gpiod::line::bias::AS_IS },
+    std::pair{ std::string_view{"disabled"}, gpiod::line::bias::DISABLED },
+    std::pair{ std::string_view{"pull-down"}, gpiod::line::bias::PULL_DOWN },
+    std::pair{ std::string_view{"pull-up"}, gpiod::line::bias::PULL_UP }
+};
+
+//-------------------------------------------------------------------------
+
+// Parse the ,bias=<bias> and ,debounce=<ms> options after the edge.
+
+bool
+parseInputOptions(
+    std::string_view options,
+    InputAction& input)
+{
+    for (bool more{true}; more;)
+    {
+        const auto comma = options.find(',');
+        const auto option = options.substr(0, comma);
+        more = (comma != std::string_view::npos);
+        options.remove_prefix(more ? comma + 1 : options.size());
+
+        const auto equals = option.find('=');
+        if (equals == std::string_view::npos)
+        {
+            return false;
+        }
+
+        const auto name = option.substr(0, equals);
+        const auto value = option.substr(equals + 1);
+
+        if (name == "bias")
+        {
+            const auto bias = std::ranges::find(c_biasNames, value, &decltype(c_biasNames)::value_type::first);
+            if (bias == c_biasNames.end())
+            {
+                return false;
+            }
+
+            input.bias = bias->second;
+        }
+        else if (name == "debounce")
+        {
+            unsigned period{0};
+            const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), period);
+            if (value.empty() or ec != std::errc{} or end != value.data() + value.size())
+            {
+                return false;
+            }
+
+            input.debouncePeriod = std::chrono::milliseconds(period);
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+gpiod::line_settings
+MonitoredLine::settings() const
+{
+    gpiod::line_settings lineSettings;
+    lineSettings.set_direction(gpiod::line::direction::INPUT);
+    lineSettings.set_edge_detection(gpiod::line::edge::BOTH);
+    lineSettings.set_bias(bias);
+    lineSettings.set_debounce_period(debouncePeriod);
+
+    return lineSettings;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+MonitoredLine::accept(
+    const EdgeEvent& event)
+{
+    if (not debouncer.accept(event.timestampNs))
+    {
+        suppressed = true;
+        return false;
+    }
+
+    pending = (event.type == gpiod::edge_event::event_type::RISING_EDGE)
+            ? gpiod::line::value::ACTIVE
+            : gpiod::line::value::INACTIVE;
+    timestampNs = event.timestampNs;
+    lineSeqno = event.lineSeqno;
+
+    return true;
+}
+
+//-------------------------------------------------------------------------
+
+bool
+MonitoredLine::settle()
+{
+    if (pending.has_value())
+    {
+        update(*pending, timestampNs, lineSeqno);
+        pending.reset();
+    }
+
+    return std::exchange(suppressed, false);
+}
+
+//-------------------------------------------------------------------------
+
+void
+MonitoredLine::update(
+    gpiod::line::value newValue,
+    std::uint64_t eventTimestampNs,
+    std::uint64_t eventLineSeqno)
+{
+    if (newValue == value)
+    {
+        return;
+    }
+
+    value = newValue;
+
+    if (handler)
+    {
+        handler(value, eventTimestampNs, eventLineSeqno);
+    }
+}
+
+//=========================================================================
+
+bool
+InputAction::triggeredBy(
+    gpiod::line::value value) const noexcept
+{
+    switch (edge)
+    {
+        case gpiod::line::edge::RISING:
+            return value == gpiod::line::value::ACTIVE;
+        case gpiod::line::edge::FALLING:
+            return value == gpiod::line::value::INACTIVE;
+        default:
+            return true;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::string_view
+InputAction::edgeName() const noexcept
+{
+    for (const auto& [name, value] : c_edgeNames)
+    {
+        if (value == edge)
+        {
+            return name;
+        }
+    }
+
+    return "unknown";
+}
+
+//-------------------------------------------------------------------------
+
+std::string_view
+InputAction::biasName() const noexcept
+{
+    for (const auto& [name, value] : c_biasNames)
+    {
+        if (value == bias)
+        {
+            return name;
+        }
+    }
+
+    return "unknown";
+}
+
+//=========================================================================
+
+std::optional<InputAction>
+parseInputAction(
+    std::string_view spec)
+{
+    // <label>:<line>:<edge>[,<option>...]:<command>, the command may
+    // contain colons.
+
+    std::array<std::string_view, 3> fields;
+
+    for (auto& field : fields)
+    {
+        const auto colon = spec.find(':');
+        if (colon == std::string_view::npos or colon == 0)
+        {
+            return std::nullopt;
+        }
+
+        field = spec.substr(0, colon);
+        spec.remove_prefix(colon + 1);
+    }
+
+    const auto comma = fields[2].find(',');
+    const auto edgeName = fields[2].substr(0, comma);
+
+    const auto edge = std::ranges::find(c_edgeNames, edgeName, &decltype(c_edgeNames)::value_type::first);
+    if (edge == c_edgeNames.end())
+    {
+        return std::nullopt;
+    }
+
+    try
+    {
+        InputAction input{
+            .label = std::string(fields[0]),
+            .line = std::string(fields[1]),
+            .edge = edge->second,
+            .action = ShutdownAction{spec}};
+
+        if (comma != std::string_view::npos and
+            not parseInputOptions(fields[2].substr(comma + 1), input))
+        {
+            return std::nullopt;
+        }
+
+        return input;
+    }
+    catch (const std::exception&)
+    {
+        return std::nullopt;
+    }
+}
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,107 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <gpiod.hpp>
+
+#include "debouncer.h"
+#include "eventSource.h"
+#include "shutdownAction.h"
+
+//-------------------------------------------------------------------------
+
+// One of the gpio lines served by the single line request: the lid switch
+// and any inputs, such as the power button or the charger detect line.
+// Each line has its own settings and debounce. The edges for a line are
+// collected while a batch is read and the handler is called once with the
+// state the line settled in.
+
+struct MonitoredLine
+{
+    using Handler = std::function<void(
+        gpiod::line::value value,
+        std::uint64_t timestampNs,
+        std::uint64_t lineSeqno)>;
+
+    std::string label{};
+    gpiod::line::offset offset{0};
+    gpiod::line::bias bias{gpiod::line::bias::PULL_UP};
+    std::chrono::milliseconds debouncePeriod{0};
+    Debouncer debouncer{};
+    Handler handler{};
+    gpiod::line::value value{gpiod::line::value::INACTIVE};
+
+    // The last edge accepted from the batch being read, and whether any
+    // were suppressed, in which case the line needs to be read again once
+    // the debounce period has passed.
+
+    std::optional<gpiod::line::value> pending{};
+    std::uint64_t timestampNs{0};
+    std::uint64_t lineSeqno{0};
+    bool suppressed{false};
+
+    [[nodiscard]] gpiod::line_settings settings() const;
+
+    bool accept(const EdgeEvent& event);
+    bool settle();
+    void update(gpiod::line::value newValue, std::uint64_t eventTimestampNs = 0, std::uint64_t eventLineSeqno = 0);
+};
+
+//-------------------------------------------------------------------------
+
+// An action called when an input changes. Given on the command line as
+// <label>:<line>:<edge>[,bias=<bias>][,debounce=<ms>]:<command>, where
+// edge is rising, falling or both and bias is pull-up, pull-down,
+// disabled or as-is. Without a debounce the lid switch's period is used.
+
+struct InputAction
+{
+    std::string label{};
+    std::string line{};
+    gpiod::line::edge edge{gpiod::line::edge::BOTH};
+    gpiod::line::bias bias{gpiod::line::bias::PULL_UP};
+    std::optional<std::chrono::milliseconds> debouncePeriod{};
+    ShutdownAction action{};
+
+    [[nodiscard]] bool triggeredBy(gpiod::line::value value) const noexcept;
+    [[nodiscard]] std::string_view edgeName() const noexcept;
+    [[nodiscard]] std::string_view biasName() const noexcept;
+};
+
+std::optional<InputAction> parseInputAction(std::string_view spec);
+
+//-------------------------------------------------------------------------
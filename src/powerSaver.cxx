@@ -0,0 +1,332 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <memory>
+#include <ranges>
+#include <string>
+
+#include "powerSaver.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+const std::filesystem::path c_cpuPath{"/sys/devices/system/cpu"};
+const std::filesystem::path c_cpufreqPath{"/sys/devices/system/cpu/cpufreq"};
+const std::filesystem::path c_drmPath{"/sys/class/drm"};
+const std::filesystem::path c_usbPath{"/sys/bus/usb/devices"};
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+monotonicNow() noexcept
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+//-------------------------------------------------------------------------
+
+// The names in a directory that satisfy the predicate, sorted so that the
+// files are always saved in the same order.
+
+template<typename Predicate>
+std::vector<std::string>
+entries(
+    const std::filesystem::path& directory,
+    Predicate predicate)
+{
+    std::vector<std::string> names;
+
+    const auto closeDir = [](DIR* dir) { ::closedir(dir); };
+    const std::unique_ptr<DIR, decltype(closeDir)> dir{::opendir(directory.c_str()), closeDir};
+    if (not dir)
+    {
+        return names;
+    }
+
+    while (const auto entry = ::readdir(dir.get()))
+    {
+        const std::string_view name{entry->d_name};
+        if (not name.starts_with('.') and predicate(name))
+        {
+            names.emplace_back(name);
+        }
+    }
+
+    std::ranges::sort(names);
+    return names;
+}
+
+//-------------------------------------------------------------------------
+
+// cpuN, but not the other entries in the cpu directory such as cpufreq.
+
+std::optional<int>
+cpuNumber(
+    std::string_view name) noexcept
+{
+    if (not name.starts_with("cpu") or name.size() == 3)
+    {
+        return std::nullopt;
+    }
+
+    int cpu{0};
+    const auto last = name.data() + name.size();
+    const auto [ptr, ec] = std::from_chars(name.data() + 3, last, cpu);
+
+    if (ec != std::errc{} or ptr != last)
+    {
+        return std::nullopt;
+    }
+
+    return cpu;
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+std::optional<unsigned>
+PowerSaver::parse(
+    std::string_view settings)
+{
+    constexpr std::array names
+    {
+        std::pair{ std::string_view{"governor"}, GOVERNOR },
+        std::pair{ std::string_view{"cpus"}, CPUS },
+        std::pair{ std::string_view{"usb"}, USB },
+        std::pair{ std::string_view{"hdmi"}, HDMI },
+        std::pair{ std::string_view{"all"}, ALL }
+    };
+
+    unsigned result{0};
+
+    for (const auto part : std::views::split(settings, ','))
+    {
+        const std::string_view name{part.begin(), part.end()};
+        const auto setting = std::ranges::find(names, name, &decltype(names)::value_type::first);
+
+        if (setting == names.end())
+        {
+            return std::nullopt;
+        }
+
+        result |= setting->second;
+    }
+
+    return (result == 0) ? std::nullopt : std::optional<unsigned>{result};
+}
+
+//-------------------------------------------------------------------------
+
+PowerSaver::PowerSaver(
+    unsigned settings,
+    std::optional<int> keepCpu)
+:
+    m_files{},
+    m_saving{false}
+{
+    // Saved in this order and restored in reverse: the peripherals first,
+    // then the governors, then the cpus.
+
+    if ((settings & HDMI) != 0)
+    {
+        // Forcing a connector off disables it. Reading the file gives the
+        // connection status, not what was forced, so restore detection.
+
+        for (const auto& name : entries(c_drmPath, [](std::string_view name) { return name.contains("-HDMI-"); }))
+        {
+            add(c_drmPath / name / "status", "off", "detect");
+        }
+    }
+
+    if ((settings & USB) != 0)
+    {
+        // Let the kernel runtime suspend idle devices, and the hubs once
+        // nothing below them is in use.
+
+        for (const auto& name : entries(c_usbPath, [](std::string_view name) { return not name.contains(':'); }))
+        {
+            add(c_usbPath / name / "power" / "control", "auto");
+        }
+    }
+
+    if ((settings & GOVERNOR) != 0)
+    {
+        for (const auto& name : entries(c_cpufreqPath, [](std::string_view name) { return name.starts_with("policy"); }))
+        {
+            add(c_cpufreqPath / name / "scaling_governor", "powersave");
+        }
+    }
+
+    if ((settings & CPUS) != 0)
+    {
+        const auto secondary = [keepCpu](std::string_view name)
+        {
+            const auto cpu = cpuNumber(name);
+            return cpu.has_value() and *cpu != 0 and cpu != keepCpu;
+        };
+
+        for (const auto& name : entries(c_cpuPath, secondary))
+        {
+            add(c_cpuPath / name / "online", "0");
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+PowerSaver::add(
+    const std::filesystem::path& path,
+    std::string_view saveValue,
+    std::string_view restoreValue)
+{
+    FileDescriptor fd{::open(path.c_str(), O_RDWR | O_CLOEXEC)};
+    if (fd.valid())
+    {
+        m_files.push_back(
+            File{
+                .fd = std::move(fd),
+                .saveValue = saveValue,
+                .restoreValue = restoreValue });
+    }
+}
+
+//-------------------------------------------------------------------------
+
+PowerSaver::Result
+PowerSaver::save() noexcept
+{
+    Result result;
+
+    if (m_saving)
+    {
+        return result;
+    }
+
+    const auto start = monotonicNow();
+
+    for (auto& file : m_files)
+    {
+        file.written = false;
+
+        const auto length = ::pread(file.fd.get(), file.saved.data(), file.saved.size(), 0);
+        if (length <= 0)
+        {
+            ++result.failed;
+            continue;
+        }
+
+        file.savedLength = static_cast<std::size_t>(length);
+
+        while (file.savedLength > 0 and file.saved[file.savedLength - 1] == '\n')
+        {
+            --file.savedLength;
+        }
+
+        const std::string_view saved{file.saved.data(), file.savedLength};
+        if (saved == file.saveValue)
+        {
+            continue;
+        }
+
+        if (::pwrite(file.fd.get(), file.saveValue.data(), file.saveValue.size(), 0) == -1)
+        {
+            ++result.failed;
+            continue;
+        }
+
+        file.written = true;
+        ++result.changed;
+    }
+
+    m_saving = true;
+    result.took = monotonicNow() - start;
+
+    return result;
+}
+
+//-------------------------------------------------------------------------
+
+PowerSaver::Result
+PowerSaver::restore() noexcept
+{
+    Result result;
+
+    if (not m_saving)
+    {
+        return result;
+    }
+
+    const auto start = monotonicNow();
+
+    // Only the files that were changed are written back.
+
+    for (auto& file : std::views::reverse(m_files))
+    {
+        if (not file.written)
+        {
+            continue;
+        }
+
+        const auto value = file.restoreValue.empty()
+                         ? std::string_view{file.saved.data(), file.savedLength}
+                         : file.restoreValue;
+
+        if (::pwrite(file.fd.get(), value.data(), value.size(), 0) == -1)
+        {
+            ++result.failed;
+        }
+        else
+        {
+            ++result.changed;
+        }
+
+        file.written = false;
+    }
+
+    m_saving = false;
+    result.took = monotonicNow() - start;
+
+    return result;
+}
@@ -0,0 +1,118 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "fileDescriptor.h"
+
+//-------------------------------------------------------------------------
+
+// Saves power while the lid is closed by writing to sysfs: the cpufreq
+// governor, the secondary cpus, USB runtime power management and the HDMI
+// connectors. The files are opened once, when constructed, so that save()
+// and restore() are only a read and a write of each file. save() keeps
+// what each file held, and restore() writes it back, in reverse order, so
+// the cpus are online again before their governor is restored.
+
+class PowerSaver
+{
+public:
+
+    enum Setting : unsigned
+    {
+        GOVERNOR = 1U << 0,
+        CPUS = 1U << 1,
+        USB = 1U << 2,
+        HDMI = 1U << 3,
+        ALL = GOVERNOR | CPUS | USB | HDMI
+    };
+
+    struct Result
+    {
+        std::size_t changed{0};
+        std::size_t failed{0};
+        std::chrono::nanoseconds took{0};
+    };
+
+    // A comma separated list of governor, cpus, usb and hdmi, or all.
+
+    static std::optional<unsigned> parse(std::string_view settings);
+
+    PowerSaver() = default;
+
+    // Files that are missing or cannot be opened are skipped. keepCpu is
+    // never taken offline, nor is cpu0, which usually cannot be.
+
+    PowerSaver(unsigned settings, std::optional<int> keepCpu);
+
+    [[nodiscard]] bool enabled() const noexcept { return not m_files.empty(); }
+    [[nodiscard]] bool saving() const noexcept { return m_saving; }
+    [[nodiscard]] std::size_t size() const noexcept { return m_files.size(); }
+
+    Result save() noexcept;
+    Result restore() noexcept;
+
+private:
+
+    static constexpr std::size_t c_maxValueLength{32};
+
+    struct File
+    {
+        FileDescriptor fd{};
+        std::string_view saveValue{};
+
+        // Written on restore instead of what was read, for files that do
+        // not read back what is written to them.
+
+        std::string_view restoreValue{};
+
+        std::array<char, c_maxValueLength> saved{};
+        std::size_t savedLength{0};
+        bool written{false};
+    };
+
+    void add(
+        const std::filesystem::path& path,
+        std::string_view saveValue,
+        std::string_view restoreValue = {});
+
+    std::vector<File> m_files{};
+    bool m_saving{false};
+};
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,109 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <pthread.h>
+#include <sched.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#include <array>
+#include <cerrno>
+#include <system_error>
+
+#include "realtime.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+// Much more than the event loop ever uses, but small compared to the
+// default thread stack.
+
+constexpr std::size_t c_prefaultStackSize{256 * 1024};
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+void
+lockMemory()
+{
+    if (::mlockall(MCL_CURRENT | MCL_FUTURE) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "mlockall");
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+prefaultStack()
+{
+    // explicit_bzero cannot be optimised away, unlike memset of an array
+    // that is never read.
+
+    std::array<unsigned char, c_prefaultStackSize> stack;
+    ::explicit_bzero(stack.data(), stack.size());
+}
+
+//-------------------------------------------------------------------------
+
+void
+setFifoPriority(
+    int priority)
+{
+    sched_param param{};
+    param.sched_priority = priority;
+
+    if (const int error = ::pthread_setschedparam(::pthread_self(), SCHED_FIFO, &param); error != 0)
+    {
+        throw std::system_error(error, std::generic_category(), "pthread_setschedparam");
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+pinToCpu(
+    int cpu)
+{
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu, &cpus);
+
+    if (const int error = ::pthread_setaffinity_np(::pthread_self(), sizeof(cpus), &cpus); error != 0)
+    {
+        throw std::system_error(error, std::generic_category(), "pthread_setaffinity_np");
+    }
+}
+
+//-------------------------------------------------------------------------
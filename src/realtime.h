@@ -0,0 +1,72 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <cstddef>
+#include <optional>
+
+//-------------------------------------------------------------------------
+
+// Optional low latency settings for the event loop thread. Each of the
+// functions throws std::system_error if the kernel refuses, which is
+// usually because the process lacks CAP_SYS_NICE or CAP_IPC_LOCK.
+
+struct RealtimeSettings
+{
+    std::optional<int> priority{};
+    std::optional<int> cpu{};
+
+    [[nodiscard]] bool enabled() const noexcept
+    {
+        return priority.has_value() or cpu.has_value();
+    }
+};
+
+//-------------------------------------------------------------------------
+
+// Lock the current and future pages of the process into memory, so that
+// handling an edge after a long idle period doesn't page fault.
+
+void lockMemory();
+
+// Touch the top of the stack so that it is mapped, and with the memory
+// locked, stays mapped.
+
+void prefaultStack();
+
+// Give the calling thread SCHED_FIFO at the given priority.
+
+void setFifoPriority(int priority);
+
+// Restrict the calling thread to the given cpu.
+
+void pinToCpu(int cpu);
+
+//-------------------------------------------------------------------------
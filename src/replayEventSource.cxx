@@ -0,0 +1,366 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <fcntl.h>
+#include <sys/eventfd.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <format>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include "replayEventSource.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+std::string
+readTrace(
+    const std::filesystem::path& path)
+{
+    const FileDescriptor fd{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (not fd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), path.string());
+    }
+
+    struct stat status{};
+    if (::fstat(fd.get(), &status) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "fstat");
+    }
+
+    std::string trace(static_cast<std::size_t>(status.st_size), '\0');
+    std::size_t done{0};
+
+    while (done < trace.size())
+    {
+        const auto length = ::read(fd.get(), trace.data() + done, trace.size() - done);
+        if (length == -1)
+        {
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+        if (length == 0)
+        {
+            break;
+        }
+
+        done += static_cast<std::size_t>(length);
+    }
+
+    trace.resize(done);
+    return trace;
+}
+
+//-------------------------------------------------------------------------
+
+std::string_view
+nextField(
+    std::string_view& line)
+{
+    const auto start = line.find_first_not_of(" \t");
+    if (start == std::string_view::npos)
+    {
+        line = {};
+        return {};
+    }
+
+    line.remove_prefix(start);
+
+    const auto end = std::min(line.find_first_of(" \t"), line.size());
+    const auto field = line.substr(0, end);
+    line.remove_prefix(end);
+
+    return field;
+}
+
+//-------------------------------------------------------------------------
+
+template<typename T>
+bool
+parseNumber(
+    std::string_view text,
+    T& value)
+{
+    const auto last = text.data() + text.size();
+    const auto [ptr, ec] = std::from_chars(text.data(), last, value);
+
+    return ec == std::errc{} and ptr == last;
+}
+
+//-------------------------------------------------------------------------
+
+std::uint64_t
+monotonicNowNs() noexcept
+{
+    timespec ts{};
+    ::clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return static_cast<std::uint64_t>(ts.tv_sec) * 1'000'000'000 + static_cast<std::uint64_t>(ts.tv_nsec);
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+ReplayEventSource::ReplayEventSource(
+    const std::filesystem::path& path)
+:
+    ReplayEventSource(parse(readTrace(path)))
+{
+}
+
+//-------------------------------------------------------------------------
+
+ReplayEventSource::ReplayEventSource(
+    std::vector<EdgeEvent> events)
+:
+    m_events{std::move(events)},
+    m_next{0},
+    m_values{},
+    m_eventFd{::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)},
+    m_readable{false},
+    m_syscalls{0}
+{
+    if (not m_eventFd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), "eventfd");
+    }
+
+    rewind();
+}
+
+//-------------------------------------------------------------------------
+
+std::vector<EdgeEvent>
+ReplayEventSource::parse(
+    std::string_view trace)
+{
+    std::vector<EdgeEvent> events;
+    std::size_t lineNumber{0};
+
+    while (not trace.empty())
+    {
+        const auto newline = std::min(trace.find('\n'), trace.size());
+        auto line = trace.substr(0, newline);
+        trace.remove_prefix(std::min(newline + 1, trace.size()));
+        ++lineNumber;
+
+        if (const auto comment = line.find('#'); comment != std::string_view::npos)
+        {
+            line = line.substr(0, comment);
+        }
+
+        const auto timestamp = nextField(line);
+        if (timestamp.empty())
+        {
+            continue;
+        }
+
+        const auto offset = nextField(line);
+        const auto edge = nextField(line);
+
+        EdgeEvent event;
+
+        if (not parseNumber(timestamp, event.timestampNs) or
+            not parseNumber(offset, event.offset) or
+            not nextField(line).empty())
+        {
+            throw std::runtime_error(std::format("cannot parse line {} of trace", lineNumber));
+        }
+
+        if (edge == "rising")
+        {
+            event.type = gpiod::edge_event::event_type::RISING_EDGE;
+        }
+        else if (edge == "falling")
+        {
+            event.type = gpiod::edge_event::event_type::FALLING_EDGE;
+        }
+        else
+        {
+            throw std::runtime_error(std::format("cannot parse line {} of trace", lineNumber));
+        }
+
+        events.push_back(event);
+    }
+
+    return events;
+}
+
+//-------------------------------------------------------------------------
+
+int
+ReplayEventSource::fd() const
+{
+    return m_eventFd.get();
+}
+
+//-------------------------------------------------------------------------
+
+bool
+ReplayEventSource::wait(
+    std::chrono::nanoseconds)
+{
+    return not finished();
+}
+
+//-------------------------------------------------------------------------
+
+std::size_t
+ReplayEventSource::read(
+    std::span<EdgeEvent> events)
+{
+    const auto count = std::min(events.size(), m_events.size() - m_next);
+    const auto batch = std::span(m_events).subspan(m_next, count);
+
+    std::ranges::copy(batch, events.begin());
+    m_next += count;
+
+    for (const auto& event : batch)
+    {
+        const auto level = (event.type == gpiod::edge_event::event_type::RISING_EDGE)
+                         ? gpiod::line::value::ACTIVE
+                         : gpiod::line::value::INACTIVE;
+
+        auto value = std::ranges::find(m_values, event.offset, &decltype(m_values)::value_type::first);
+        if (value == m_values.end())
+        {
+            m_values.emplace_back(event.offset, level);
+        }
+        else
+        {
+            value->second = level;
+        }
+    }
+
+    if (finished())
+    {
+        signal(false);
+    }
+
+    return count;
+}
+
+//-------------------------------------------------------------------------
+
+void
+ReplayEventSource::rewind()
+{
+    // Move the timestamps so that the first edge is now, keeping the gaps
+    // between them, and number the edges as the kernel would.
+
+    if (not m_events.empty())
+    {
+        const auto base = m_events.front().timestampNs;
+        const auto now = monotonicNowNs();
+
+        std::vector<std::pair<gpiod::line::offset, std::uint64_t>> lineSeqnos;
+        std::uint64_t globalSeqno{0};
+
+        for (auto& event : m_events)
+        {
+            event.timestampNs = event.timestampNs - base + now;
+            event.globalSeqno = ++globalSeqno;
+
+            auto seqno = std::ranges::find(lineSeqnos, event.offset, &decltype(lineSeqnos)::value_type::first);
+            if (seqno == lineSeqnos.end())
+            {
+                lineSeqnos.emplace_back(event.offset, 0);
+                seqno = std::prev(lineSeqnos.end());
+            }
+
+            event.lineSeqno = ++seqno->second;
+        }
+    }
+
+    m_next = 0;
+    m_values.clear();
+    signal(not finished());
+}
+
+//-------------------------------------------------------------------------
+
+void
+ReplayEventSource::signal(
+    bool readable)
+{
+    // The eventfd is readable while its count is non-zero, which is
+    // while there are edges left to replay.
+
+    if (readable == m_readable)
+    {
+        return;
+    }
+
+    ++m_syscalls;
+
+    if (readable)
+    {
+        const std::uint64_t one{1};
+        if (::write(m_eventFd.get(), &one, sizeof(one)) == -1)
+        {
+            throw std::system_error(errno, std::generic_category(), "write");
+        }
+    }
+    else
+    {
+        std::uint64_t count{0};
+        if (::read(m_eventFd.get(), &count, sizeof(count)) == -1)
+        {
+            throw std::system_error(errno, std::generic_category(), "read");
+        }
+    }
+
+    m_readable = readable;
+}
+
+//-------------------------------------------------------------------------
+
+gpiod::line::value
+ReplayEventSource::value(
+    gpiod::line::offset offset)
+{
+    const auto value = std::ranges::find(m_values, offset, &decltype(m_values)::value_type::first);
+
+    return (value == m_values.end()) ? gpiod::line::value::ACTIVE : value->second;
+}
+
+//-------------------------------------------------------------------------
@@ -0,0 +1,91 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "eventSource.h"
+#include "fileDescriptor.h"
+
+//-------------------------------------------------------------------------
+
+// Replays a recorded trace of edges as fast as they can be read, so that
+// field captures can be reproduced, and the debounce and state handling
+// measured, without the hardware. A trace has one edge per line
+//
+//     <timestamp ns> <line offset> <rising|falling>
+//
+// with blank lines and # comments ignored. The timestamps are moved so
+// that the first edge is at the time the trace was loaded, and the
+// sequence numbers are generated. Until a line has an edge it reads as
+// active, which is the open lid with the pull up.
+
+class ReplayEventSource : public EventSource
+{
+public:
+
+    explicit ReplayEventSource(const std::filesystem::path& path);
+    explicit ReplayEventSource(std::vector<EdgeEvent> events);
+
+    // Throws std::runtime_error giving the line that cannot be parsed.
+
+    static std::vector<EdgeEvent> parse(std::string_view trace);
+
+    [[nodiscard]] int fd() const override;
+    bool wait(std::chrono::nanoseconds timeout) override;
+    std::size_t read(std::span<EdgeEvent> events) override;
+    gpiod::line::value value(gpiod::line::offset offset) override;
+
+    [[nodiscard]] std::uint64_t syscalls() const noexcept override { return m_syscalls; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return m_events.size(); }
+    [[nodiscard]] bool finished() const noexcept { return m_next == m_events.size(); }
+
+    void rewind();
+
+private:
+
+    void signal(bool readable);
+
+    std::vector<EdgeEvent> m_events{};
+    std::size_t m_next{0};
+    std::vector<std::pair<gpiod::line::offset, gpiod::line::value>> m_values{};
+    FileDescriptor m_eventFd{};
+    bool m_readable{false};
+    std::uint64_t m_syscalls{0};
+};
+
+//-------------------------------------------------------------------------
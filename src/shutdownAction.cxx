@@ -0,0 +1,316 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <errno.h>
+#include <signal.h>
+#include <spawn.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <stdexcept>
+#include <system_error>
+
+#include "shutdownAction.h"
+
+//-------------------------------------------------------------------------
+
+extern char** environ;
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+struct KnownCommand
+{
+    std::string_view command;
+    ShutdownAction::Method method;
+};
+
+constexpr std::array c_knownCommands
+{
+    KnownCommand{ "shutdown -h now", ShutdownAction::Method::POWER_OFF },
+    KnownCommand{ "shutdown -P now", ShutdownAction::Method::POWER_OFF },
+    KnownCommand{ "poweroff", ShutdownAction::Method::POWER_OFF },
+    KnownCommand{ "systemctl poweroff", ShutdownAction::Method::POWER_OFF },
+    KnownCommand{ "systemctl suspend", ShutdownAction::Method::SUSPEND },
+    KnownCommand{ "systemctl hibernate", ShutdownAction::Method::HIBERNATE }
+};
+
+//-------------------------------------------------------------------------
+
+const char*
+logindMethodName(
+    ShutdownAction::Method method)
+{
+    switch (method)
+    {
+        case ShutdownAction::Method::POWER_OFF:
+            return "PowerOff";
+        case ShutdownAction::Method::SUSPEND:
+            return "Suspend";
+        case ShutdownAction::Method::HIBERNATE:
+            return "Hibernate";
+        default:
+            return nullptr;
+    }
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+ShutdownAction::ShutdownAction(
+    std::string_view command)
+:
+    m_command(command),
+    m_arguments(split(command)),
+    m_method{Method::COMMAND},
+    m_bus{nullptr, &sd_bus_flush_close_unref}
+{
+    if (m_arguments.empty())
+    {
+        throw std::invalid_argument("empty shutdown command");
+    }
+
+    // Compare the words, so that extra white space doesn't matter.
+
+    for (const auto& known : c_knownCommands)
+    {
+        if (split(known.command) == m_arguments)
+        {
+            m_method = known.method;
+            break;
+        }
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ShutdownAction::callLogind() const
+{
+    sd_bus_error error = SD_BUS_ERROR_NULL;
+
+    const int result = sd_bus_call_method(
+        m_bus.get(),
+        "org.freedesktop.login1",
+        "/org/freedesktop/login1",
+        "org.freedesktop.login1.Manager",
+        logindMethodName(m_method),
+        &error,
+        nullptr,
+        "b",
+        0);
+
+    if (result < 0)
+    {
+        const std::string message = (error.message != nullptr) ? error.message : "";
+        sd_bus_error_free(&error);
+
+        throw std::system_error(
+            -result,
+            std::generic_category(),
+            std::format("logind {} {}", logindMethodName(m_method), message));
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+ShutdownAction::connect()
+{
+    // Open the bus connection up front, so the shutdown doesn't wait on it.
+
+    if (m_method == Method::COMMAND or m_bus)
+    {
+        return;
+    }
+
+    sd_bus* bus{nullptr};
+    const int result = sd_bus_open_system(&bus);
+
+    if (result < 0)
+    {
+        throw std::system_error(-result, std::generic_category(), "sd_bus_open_system");
+    }
+
+    m_bus.reset(bus);
+}
+
+//-------------------------------------------------------------------------
+
+std::string_view
+ShutdownAction::description() const
+{
+    switch (m_method)
+    {
+        case Method::POWER_OFF:
+            return "logind PowerOff";
+        case Method::SUSPEND:
+            return "logind Suspend";
+        case Method::HIBERNATE:
+            return "logind Hibernate";
+        default:
+            return "command";
+    }
+}
+
+//-------------------------------------------------------------------------
+
+ShutdownAction::Started
+ShutdownAction::run() const
+{
+    if (m_method != Method::COMMAND and m_bus)
+    {
+        try
+        {
+            callLogind();
+            return Started{};
+        }
+        catch (const std::system_error& e)
+        {
+            return Started{ .pid = spawn(), .logindError = e.what() };
+        }
+    }
+
+    return Started{ .pid = spawn() };
+}
+
+//-------------------------------------------------------------------------
+
+pid_t
+ShutdownAction::spawn() const
+{
+    std::vector<char*> argv;
+    argv.reserve(m_arguments.size() + 1);
+
+    for (const auto& argument : m_arguments)
+    {
+        argv.push_back(const_cast<char*>(argument.c_str()));
+    }
+
+    argv.push_back(nullptr);
+
+    // The monitor blocks the signals it handles with a signalfd. Unblock
+    // them, and restore their default actions, in the child.
+
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+
+    sigset_t signals;
+    sigemptyset(&signals);
+    posix_spawnattr_setsigmask(&attributes, &signals);
+
+    sigfillset(&signals);
+    sigdelset(&signals, SIGKILL);
+    sigdelset(&signals, SIGSTOP);
+    posix_spawnattr_setsigdefault(&attributes, &signals);
+
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    pid_t pid{0};
+    const int result = ::posix_spawnp(
+        &pid,
+        argv[0],
+        nullptr,
+        &attributes,
+        argv.data(),
+        environ);
+
+    posix_spawnattr_destroy(&attributes);
+
+    if (result != 0)
+    {
+        throw std::system_error(result, std::generic_category(), "posix_spawnp " + m_arguments[0]);
+    }
+
+    return pid;
+}
+
+//-------------------------------------------------------------------------
+
+std::vector<std::string>
+ShutdownAction::split(
+    std::string_view command)
+{
+    // Split on white space. Single or double quotes group words, with no
+    // escapes inside them.
+
+    std::vector<std::string> words;
+    std::string word;
+    bool inWord{false};
+    char quote{'\0'};
+
+    for (const char c : command)
+    {
+        if (quote != '\0')
+        {
+            if (c == quote)
+            {
+                quote = '\0';
+            }
+            else
+            {
+                word += c;
+            }
+        }
+        else if (c == '\'' or c == '"')
+        {
+            quote = c;
+            inWord = true;
+        }
+        else if (c == ' ' or c == '\t' or c == '\n')
+        {
+            if (inWord)
+            {
+                words.push_back(std::move(word));
+                word.clear();
+                inWord = false;
+            }
+        }
+        else
+        {
+            word += c;
+            inWord = true;
+        }
+    }
+
+    if (inWord)
+    {
+        words.push_back(std::move(word));
+    }
+
+    return words;
+}
+
@@ -0,0 +1,113 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <systemd/sd-bus.h>
+
+//-------------------------------------------------------------------------
+
+// The action taken when the lid has been closed for long enough. Commands
+// that are known to power off, suspend or hibernate the machine are sent
+// directly to logind over D-Bus. Any other command is split into words
+// once, when it is set, and run with posix_spawnp without a shell, so
+// shell syntax other than quoting is not supported. If the logind call
+// fails the command is run instead. The command is not waited for, the
+// caller reaps it, so a slow command never holds up the event loop.
+
+class ShutdownAction
+{
+public:
+
+    enum class Method
+    {
+        COMMAND,
+        POWER_OFF,
+        SUSPEND,
+        HIBERNATE
+    };
+
+    // What run() did. pid is the command started, for the caller to reap,
+    // or -1 if logind carried out the action. If the logind call failed
+    // and the command was started instead, logindError says why.
+
+    struct Started
+    {
+        pid_t pid{-1};
+        std::string logindError{};
+    };
+
+    explicit ShutdownAction(std::string_view command = "shutdown -h now");
+
+    void connect();
+
+    // Throws std::system_error if the command cannot be started.
+
+    [[nodiscard]] Started run() const;
+
+    [[nodiscard]] const std::string& command() const noexcept { return m_command; }
+    [[nodiscard]] Method method() const noexcept { return m_method; }
+    [[nodiscard]] std::string_view description() const;
+
+    static std::vector<std::string> split(std::string_view command);
+
+private:
+
+    using sdBus_ptr = std::unique_ptr<sd_bus, decltype(&sd_bus_flush_close_unref)>;
+
+    void callLogind() const;
+    pid_t spawn() const;
+
+    std::string m_command{};
+    std::vector<std::string> m_arguments{};
+    Method m_method{Method::COMMAND};
+    sdBus_ptr m_bus{nullptr, &sd_bus_flush_close_unref};
+};
+
+//-------------------------------------------------------------------------
+
+// One step of the lid closed pipeline, run when the lid has been closed
+// for delay.
+
+struct ActionTier
+{
+    std::chrono::seconds delay{0};
+    ShutdownAction action{};
+};
+
+//-------------------------------------------------------------------------
+
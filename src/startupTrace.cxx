@@ -0,0 +1,119 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <syslog.h>
+#include <time.h>
+
+#include <format>
+
+#include "logger.h"
+#include "startupTrace.h"
+
+//=========================================================================
+
+namespace
+{
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+clockNow(
+    clockid_t clock) noexcept
+{
+    timespec ts{};
+    ::clock_gettime(clock, &ts);
+
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+//-------------------------------------------------------------------------
+
+} // namespace
+
+//=========================================================================
+
+StartupTrace::StartupTrace(
+    bool enabled) noexcept
+:
+    m_enabled{enabled},
+    m_start{enabled ? clockNow(CLOCK_MONOTONIC) : std::chrono::nanoseconds{0}},
+    m_last{m_start},
+    m_phases{},
+    m_count{0}
+{
+}
+
+//-------------------------------------------------------------------------
+
+void
+StartupTrace::mark(
+    std::string_view phase) noexcept
+{
+    if (not m_enabled or m_count == m_phases.size())
+    {
+        return;
+    }
+
+    const auto now = clockNow(CLOCK_MONOTONIC);
+
+    m_phases[m_count++] = Phase{ .name = phase, .took = now - m_last };
+    m_last = now;
+}
+
+//-------------------------------------------------------------------------
+
+void
+StartupTrace::log(
+    Logger& logger) const
+{
+    if (not m_enabled)
+    {
+        return;
+    }
+
+    using Microseconds = std::chrono::duration<double, std::micro>;
+
+    for (std::size_t i = 0 ; i < m_count ; ++i)
+    {
+        logger.log(
+            LOG_INFO,
+            std::format(
+                "startup {}: {:.0f}us",
+                m_phases[i].name,
+                Microseconds(m_phases[i].took).count()));
+    }
+
+    // CLOCK_BOOTTIME counts from boot, so also shows how long the system
+    // took to get to starting the service.
+
+    logger.log(
+        LOG_INFO,
+        std::format(
+            "startup took {:.0f}us, ready {:.3f}s after boot",
+            Microseconds(m_last - m_start).count(),
+            std::chrono::duration<double>(clockNow(CLOCK_BOOTTIME)).count()));
+}
@@ -0,0 +1,74 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+//-------------------------------------------------------------------------
+
+class Logger;
+
+//-------------------------------------------------------------------------
+
+// Times the phases of startup. The timings are only kept until the service
+// is ready and are then logged together, so that tracing adds no more than
+// a clock read to the phases it is timing. When disabled, mark() does
+// nothing.
+
+class StartupTrace
+{
+public:
+
+    static constexpr std::size_t c_maxPhases{12};
+
+    explicit StartupTrace(bool enabled) noexcept;
+
+    void mark(std::string_view phase) noexcept;
+    void log(Logger& logger) const;
+
+private:
+
+    struct Phase
+    {
+        std::string_view name{};
+        std::chrono::nanoseconds took{0};
+    };
+
+    bool m_enabled{false};
+    std::chrono::nanoseconds m_start{0};
+    std::chrono::nanoseconds m_last{0};
+    std::array<Phase, c_maxPhases> m_phases{};
+    std::size_t m_count{0};
+};
+
+//-------------------------------------------------------------------------
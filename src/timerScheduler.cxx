@@ -0,0 +1,222 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#include <errno.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+
+#include "timerScheduler.h"
+
+//-------------------------------------------------------------------------
+
+using namespace std::chrono_literals;
+
+//=========================================================================
+
+TimerScheduler::TimerScheduler(
+    clockid_t clockId)
+:
+    m_clockId{clockId},
+    m_timerFd{::timerfd_create(clockId, TFD_NONBLOCK | TFD_CLOEXEC)},
+    m_slots{},
+    m_size{0},
+    m_armedCount{0},
+    m_programmed{0},
+    m_syscalls{0}
+{
+    if (not m_timerFd.valid())
+    {
+        throw std::system_error(errno, std::generic_category(), "timerfd_create");
+    }
+}
+
+//-------------------------------------------------------------------------
+
+TimerScheduler::TimerId
+TimerScheduler::add(
+    Callback callback)
+{
+    if (m_size == c_maxTimers)
+    {
+        throw std::length_error("too many timers");
+    }
+
+    m_slots[m_size].callback = std::move(callback);
+
+    return m_size++;
+}
+
+//-------------------------------------------------------------------------
+
+void
+TimerScheduler::arm(
+    TimerId id,
+    std::chrono::nanoseconds timeout)
+{
+    auto& slot = m_slots.at(id);
+
+    if (not slot.armed)
+    {
+        slot.armed = true;
+        ++m_armedCount;
+    }
+
+    slot.deadline = now() + timeout;
+
+    // Only reprogram the timerfd if this deadline is now the earliest. A
+    // later deadline is picked up when the earlier one is dispatched.
+
+    if (m_programmed == 0ns or slot.deadline < m_programmed)
+    {
+        program(slot.deadline);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+TimerScheduler::cancel(
+    TimerId id)
+{
+    auto& slot = m_slots.at(id);
+
+    if (not slot.armed)
+    {
+        return;
+    }
+
+    slot.armed = false;
+
+    // If other timers are still pending the timerfd is left as is and any
+    // early expiry is treated as spurious by dispatch().
+
+    if (--m_armedCount == 0)
+    {
+        program(0ns);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+void
+TimerScheduler::dispatch()
+{
+    std::uint64_t expirations{0};
+    ++m_syscalls;
+
+    if (::read(m_timerFd.get(), &expirations, sizeof(expirations)) == -1)
+    {
+        return;
+    }
+
+    m_programmed = 0ns;
+
+    const auto current = now();
+
+    for (auto& slot : m_slots)
+    {
+        if (slot.armed and slot.deadline <= current)
+        {
+            slot.armed = false;
+            --m_armedCount;
+            slot.callback();
+        }
+    }
+
+    // Callbacks may have re-armed timers, so find the earliest deadline
+    // once they have all run.
+
+    std::chrono::nanoseconds earliest{0};
+
+    for (const auto& slot : m_slots)
+    {
+        if (slot.armed and (earliest == 0ns or slot.deadline < earliest))
+        {
+            earliest = slot.deadline;
+        }
+    }
+
+    if (earliest != 0ns)
+    {
+        program(earliest);
+    }
+}
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+TimerScheduler::now() const
+{
+    timespec ts{};
+    ::clock_gettime(m_clockId, &ts);
+
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+//-------------------------------------------------------------------------
+
+void
+TimerScheduler::program(
+    std::chrono::nanoseconds deadline)
+{
+    const auto seconds = std::chrono::floor<std::chrono::seconds>(deadline);
+
+    itimerspec spec{};
+    spec.it_value.tv_sec = seconds.count();
+    spec.it_value.tv_nsec = (deadline - seconds).count();
+
+    ++m_syscalls;
+
+    if (::timerfd_settime(m_timerFd.get(), TFD_TIMER_ABSTIME, &spec, nullptr) == -1)
+    {
+        throw std::system_error(errno, std::generic_category(), "timerfd_settime");
+    }
+
+    m_programmed = deadline;
+}
+
+//-------------------------------------------------------------------------
+
+std::chrono::nanoseconds
+TimerScheduler::remaining(
+    TimerId id) const
+{
+    const auto& slot = m_slots.at(id);
+
+    if (not slot.armed)
+    {
+        return 0ns;
+    }
+
+    return std::max(slot.deadline - now(), 0ns);
+}
+
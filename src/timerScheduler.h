@@ -0,0 +1,91 @@
+//-------------------------------------------------------------------------
+//
+// The MIT License (MIT)
+//
+// Copyright (c) 2026 Andrew Duncan
+//
+// Permission is hereby granted, free of charge, to any person obtaining a
+// copy of this software and associated documentation files (the
+// "Software"), to deal in the Software without restriction, including
+// without limitation the rights to use, copy, modify, merge, publish,
+// distribute, sublicense, and/or sell copies of the Software, and to
+// permit persons to whom the Software is furnished to do so, subject to
+// the following conditions:
+//
+// The above copyright notice and this permission notice shall be included
+// in all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+// OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+// MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+// IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+// CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+// TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+// SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+//
+//-------------------------------------------------------------------------
+
+#pragma once
+
+//-------------------------------------------------------------------------
+
+#include <time.h>
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+
+#include "fileDescriptor.h"
+
+//-------------------------------------------------------------------------
+
+// A fixed set of deadlines multiplexed onto a single timerfd. Arming and
+// cancelling a timer only touches its own slot and, if it changes the
+// earliest deadline, the timerfd. No threads are created.
+
+class TimerScheduler
+{
+public:
+
+    using Callback = std::function<void()>;
+    using TimerId = std::size_t;
+
+    static constexpr std::size_t c_maxTimers{8};
+
+    explicit TimerScheduler(clockid_t clockId = CLOCK_MONOTONIC);
+
+    TimerId add(Callback callback);
+    void arm(TimerId id, std::chrono::nanoseconds timeout);
+    void cancel(TimerId id);
+    void dispatch();
+
+    [[nodiscard]] bool armed(TimerId id) const { return m_slots.at(id).armed; }
+    [[nodiscard]] clockid_t clock() const noexcept { return m_clockId; }
+    [[nodiscard]] int fd() const noexcept { return m_timerFd.get(); }
+    [[nodiscard]] std::chrono::nanoseconds now() const;
+    [[nodiscard]] std::chrono::nanoseconds remaining(TimerId id) const;
+    [[nodiscard]] std::uint64_t syscalls() const noexcept { return m_syscalls; }
+
+private:
+
+    struct Slot
+    {
+        Callback callback{};
+        std::chrono::nanoseconds deadline{0};
+        bool armed{false};
+    };
+
+    void program(std::chrono::nanoseconds deadline);
+
+    clockid_t m_clockId{CLOCK_MONOTONIC};
+    FileDescriptor m_timerFd{};
+    std::array<Slot, c_maxTimers> m_slots{};
+    std::size_t m_size{0};
+    std::size_t m_armedCount{0};
+    std::chrono::nanoseconds m_programmed{0};
+    std::uint64_t m_syscalls{0};
+};
+
+//-------------------------------------------------------------------------
+